@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <filesystem>
+#include <fstream>
+#include "BatchLoader.hpp"
+#include "BenchSchema.hpp"
+
+void benchmark_batch_load(size_t files, size_t lines)
+{
+    const auto dir = std::filesystem::temp_directory_path() / ("cliniarg_bench_batch_" + std::to_string(files));
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> filenames;
+    for (size_t i = 0; i < files; ++i)
+    {
+        const auto path = dir / (std::to_string(i) + ".ini");
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << make_schema_ini(lines);
+        filenames.push_back(path.string());
+    }
+
+    BENCHMARK( bench_name("get_file and schema load, files", files) ) {
+        size_t valid = 0;
+        for (const auto& filename : filenames)
+        {
+            BenchProperties props{};
+            const auto& file = get_file(filename);
+            valid += file && BenchSchema::load(props, split_lines(file.get()).get()).is_valid();
+        }
+        return valid;
+    };
+    for (size_t threads : {size_t{1}, size_t{4}, size_t{std::thread::hardware_concurrency()}})
+        BENCHMARK( bench_name("batch_load " + std::to_string(threads) + " threads, files", files) ) {
+            return batch_load<BenchSchema>(filenames, {}, threads).size();
+        };
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE( "Batch loading benchmark" ) {
+    benchmark_batch_load(1'000, small_size);
+}
+
+TEST_CASE( "Batch loading benchmark, many files", "[.][large]" ) {
+    benchmark_batch_load(medium_size, small_size);
+}
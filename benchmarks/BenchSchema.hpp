@@ -0,0 +1,50 @@
+/**
+ * @file BenchSchema.hpp
+ * @brief Schema of the make_ini keys, shared by the schema loading benchmarks
+ *
+ */
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Schema.hpp"
+#include "Generators.hpp"
+
+struct BenchProperties {
+    long intparam;
+    double floatparam;
+    std::vector<double> vectorparam;
+    std::string stringparam;
+};
+
+/**
+ * @brief Schema of the keys of make_ini, without their numbers
+ *
+ */
+using BenchSchema = schema<
+    field<"intparameter", &BenchProperties::intparam>,
+    field<"floatparameter", &BenchProperties::floatparam>,
+    field<"vectorparameter", &BenchProperties::vectorparam>,
+    field<"stringparameter", &BenchProperties::stringparam>>;
+
+/**
+ * @brief make_ini content, with the line numbers removed from the keys
+ *
+ */
+inline std::string make_schema_ini(size_t lines)
+{
+    std::string str = make_ini(lines);
+    std::string res;
+    res.reserve(str.size());
+    bool in_key = true;
+    for (char c : str)
+    {
+        if (c == '\n')
+            in_key = true;
+        else if (c == '=' || c == '#')
+            in_key = false;
+        if (!(in_key && c >= '0' && c <= '9'))
+            res += c;
+    }
+    return res;
+}
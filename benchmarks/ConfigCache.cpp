@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <filesystem>
+#include <fstream>
+#include "ConfigCache.hpp"
+#include "BenchSchema.hpp"
+
+void benchmark_cached_load(size_t lines)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("cliniarg_bench_cache_" + std::to_string(lines) + ".ini");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << make_schema_ini(lines);
+    }
+    const std::string cache = path.string() + ".cache";
+
+    BENCHMARK( bench_name("map_file and schema load", lines) ) {
+        BenchProperties props{};
+        const auto& file = map_file(path.string());
+        return BenchSchema::load(props, split_lines(file.get()).get()).is_valid();
+    };
+    BENCHMARK( bench_name("cached_load, cache miss", lines) ) {
+        std::filesystem::remove(cache);
+        BenchProperties props{};
+        return cached_load<BenchSchema>(props, path.string(), cache).is_valid();
+    };
+    BENCHMARK( bench_name("cached_load, cache hit", lines) ) {
+        BenchProperties props{};
+        return cached_load<BenchSchema>(props, path.string(), cache).get() == cache_status::hit;
+    };
+
+    std::filesystem::remove(cache);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE( "Cached loading benchmark" ) {
+    benchmark_cached_load(small_size);
+    benchmark_cached_load(medium_size);
+}
+
+TEST_CASE( "Cached loading benchmark, large files", "[.][large]" ) {
+    benchmark_cached_load(large_size);
+    benchmark_cached_load(huge_size);
+}
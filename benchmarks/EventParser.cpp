@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "EventParser.hpp"
+#include "Generators.hpp"
+
+void benchmark_event_parser(size_t lines)
+{
+    const std::string str = make_ini(lines);
+
+    BENCHMARK( bench_name("split_lines and split_keyvalue_pair, all lines", lines) ) {
+        size_t keys = 0;
+        const auto& split = split_lines(str);
+        for (const auto& line : split.get())
+            keys += split_keyvalue_pair(line).is_valid();
+        return keys;
+    };
+    BENCHMARK( bench_name("parse_events, all lines", lines) ) {
+        size_t keys = 0;
+        for (const parse_event& e : parse_events(str))
+            keys += e.type == event_type::keyvalue;
+        return keys;
+    };
+
+    // the second line of make_ini: the stream stops right away
+    BENCHMARK( bench_name("split_lines, first key", lines) ) {
+        const auto& split = split_lines(str);
+        return split_keyvalue_pair(split.get()[1]).is_valid();
+    };
+    BENCHMARK( bench_name("parse_events, first key", lines) ) {
+        for (const parse_event& e : parse_events(str))
+            if (e.type == event_type::keyvalue)
+                return e.value.size();
+        return size_t{0};
+    };
+}
+
+TEST_CASE( "Event parser benchmark" ) {
+    benchmark_event_parser(small_size);
+    benchmark_event_parser(medium_size);
+}
+
+TEST_CASE( "Event parser benchmark, large inputs", "[.][large]" ) {
+    benchmark_event_parser(large_size);
+    benchmark_event_parser(huge_size);
+}
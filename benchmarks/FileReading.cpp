@@ -0,0 +1,35 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <filesystem>
+#include <fstream>
+#include "CliniParser.hpp"
+#include "MappedFile.hpp"
+#include "Generators.hpp"
+
+void benchmark_file_reading(size_t lines)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("cliniarg_bench_" + std::to_string(lines) + ".ini");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << make_ini(lines);
+    }
+
+    BENCHMARK( bench_name("get_file", lines) ) {
+        return get_file(path.string()).get().size();
+    };
+    BENCHMARK( bench_name("map_file", lines) ) {
+        return map_file(path.string()).get().size();
+    };
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE( "File reading benchmark" ) {
+    benchmark_file_reading(small_size);
+    benchmark_file_reading(medium_size);
+}
+
+TEST_CASE( "File reading benchmark, large files", "[.][large]" ) {
+    benchmark_file_reading(large_size);
+    benchmark_file_reading(huge_size);
+}
@@ -0,0 +1,203 @@
+/**
+ * @file Generators.hpp
+ * @brief Deterministic synthetic inputs shared by the benchmarks
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Input sizes, in lines (or arguments), of the default benchmarks
+ *
+ */
+inline constexpr std::size_t small_size = 100;
+inline constexpr std::size_t medium_size = 10'000;
+
+/**
+ * @brief Input sizes of the benchmarks tagged [.][large], run on demand
+ *
+ */
+inline constexpr std::size_t large_size = 1'000'000;
+inline constexpr std::size_t huge_size = 10'000'000;
+
+/**
+ * @brief Input sizes in bytes, for make_ini_bytes
+ *
+ */
+inline constexpr std::size_t megabyte = std::size_t{1} << 20;
+inline constexpr std::size_t gigabyte = std::size_t{1} << 30;
+
+/**
+ * @brief Small linear congruential generator, so that inputs do not change between runs
+ *
+ */
+class input_rng
+{
+public:
+    explicit input_rng(std::uint64_t seed = 42) : m_state(seed) {}
+
+    std::uint64_t operator()(std::uint64_t bound)
+    {
+        m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+        return (m_state >> 33) % bound;
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+/**
+ * @brief Comma separated vector of size numbers, as vector_parse<double> reads it
+ *
+ * @param size number of values
+ * @param rng
+ * @return std::string
+ */
+inline std::string make_vector_value(std::size_t size, input_rng& rng)
+{
+    std::string str;
+    str.reserve(size * 8);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+            str += ',';
+        str += std::to_string(rng(100000)) + "." + std::to_string(rng(1000));
+    }
+    return str;
+}
+
+/**
+ * @brief Append line i of the make_ini content to str
+ *
+ */
+inline void append_ini_line(std::string& str, std::size_t i, std::size_t vector_size, input_rng& rng)
+{
+    switch (i % 10)
+    {
+    case 0:
+        str += "# comment line " + std::to_string(i) + "\n";
+        break;
+    case 1: case 4: case 7:
+        str += "Int_Parameter " + std::to_string(i) + " = " + std::to_string(rng(1000000)) + "\n";
+        break;
+    case 2: case 5: case 8:
+        str += "float_parameter_" + std::to_string(i) + "=" + std::to_string(rng(1000)) + ".25e-3\n";
+        break;
+    case 3: case 6:
+        str += "vector_parameter_" + std::to_string(i) + "=" + make_vector_value(vector_size, rng) + "\n";
+        break;
+    default:
+        str += "StringParameter" + std::to_string(i) + "=some_value_" + std::to_string(rng(1000)) + "\n";
+    }
+}
+
+/**
+ * @brief INI-like content of lines lines: one comment every 10 lines, keys
+ * with spaces and underscores, integer, float, string and vector values
+ *
+ * @param lines
+ * @param vector_size number of values of the vector lines (long values above 1000)
+ * @return std::string
+ */
+inline std::string make_ini(std::size_t lines, std::size_t vector_size = 8)
+{
+    input_rng rng;
+    std::string str;
+    str.reserve(lines * (24 + (vector_size * 8) / 4));
+    for (std::size_t i = 0; i < lines; ++i)
+        append_ini_line(str, i, vector_size, rng);
+    return str;
+}
+
+/**
+ * @brief make_ini content of at most bytes bytes, cut after the last whole line
+ *
+ * @param bytes
+ * @return std::string
+ */
+inline std::string make_ini_bytes(std::size_t bytes)
+{
+    input_rng rng;
+    std::string str;
+    str.reserve(bytes + 256);
+    for (std::size_t i = 0;; ++i)
+    {
+        const std::size_t size = str.size();
+        append_ini_line(str, i, 8, rng);
+        if (str.size() > bytes)
+        {
+            str.resize(size);
+            return str;
+        }
+    }
+}
+
+/**
+ * @brief make_ini content cut in sections of section_size lines, "[component_<n>]"
+ *
+ * @param lines
+ * @param section_size
+ * @return std::string
+ */
+inline std::string make_sectioned_ini(std::size_t lines, std::size_t section_size = 50)
+{
+    const std::string body = make_ini(lines);
+    std::string str;
+    str.reserve(body.size() + (lines / section_size + 1) * 20);
+    std::size_t line = 0;
+    for (std::size_t first = 0; first < body.size(); ++line)
+    {
+        if (line % section_size == 0)
+            str += "[component_" + std::to_string(line / section_size) + "]\n";
+        const std::size_t last = body.find('\n', first) + 1;
+        str.append(body, first, last - first);
+        first = last;
+    }
+    return str;
+}
+
+/**
+ * @brief Command line of args key=value arguments separated by spaces and tabs
+ *
+ * @param args
+ * @return std::string
+ */
+inline std::string make_commandline(std::size_t args)
+{
+    input_rng rng;
+    std::string str;
+    str.reserve(args * 20);
+    for (std::size_t i = 0; i < args; ++i)
+        str += "param_" + std::to_string(i) + "=" + std::to_string(rng(100000)) + (i % 4 == 3 ? "\t" : " ");
+    return str;
+}
+
+/**
+ * @brief Label of a benchmark, with its input size
+ *
+ * @param name
+ * @param size
+ * @return std::string
+ */
+inline std::string bench_name(const std::string& name, std::size_t size)
+{
+    return name + " " + std::to_string(size);
+}
+
+/**
+ * @brief Label of a benchmark, with its input size in bytes ("1MB", "1GB")
+ *
+ * @param name
+ * @param bytes
+ * @return std::string
+ */
+inline std::string bench_bytes_name(const std::string& name, std::size_t bytes)
+{
+    if (bytes >= gigabyte)
+        return name + " " + std::to_string(bytes / gigabyte) + "GB";
+    if (bytes >= megabyte)
+        return name + " " + std::to_string(bytes / megabyte) + "MB";
+    return name + " " + std::to_string(bytes) + "B";
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <map>
+#include "IniIndex.hpp"
+#include "Generators.hpp"
+
+/**
+ * @brief Node-based reference: normalized section -> normalized key -> raw value
+ *
+ */
+using nested_map = std::map<std::string, std::map<std::string, std::string>>;
+
+nested_map make_nested_map(const std::string& str)
+{
+    nested_map res;
+    std::string section;
+    const auto& lines = split_lines(str);
+    for (const auto& line : lines.get())
+    {
+        const std::string_view text = ::detail::to_string_view(line);
+        if (text.front() == '[')
+            section = trim_spaces_underscores_andlower(std::string(text.substr(1, text.size() - 2)));
+        else
+        {
+            const auto& kv = split_keyvalue_pair(line);
+            res[section][trim_spaces_underscores_andlower(to<std::string>(kv.get().first))] = to<std::string>(kv.get().second);
+        }
+    }
+    return res;
+}
+
+void benchmark_ini_index(size_t lines)
+{
+    const std::string str = make_sectioned_ini(lines);
+    const size_t sections = lines / 50;
+    std::vector<std::pair<std::string, std::string>> queries;
+    input_rng rng;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        const size_t line = rng(lines);
+        if (line % 10 != 0) // not a comment
+            queries.emplace_back("component_" + std::to_string(line / 50), "int_parameter " + std::to_string(line));
+    }
+
+    BENCHMARK( bench_name("ini_index build", lines) ) {
+        return ini_index::build(str).get().size();
+    };
+    BENCHMARK( bench_name("map of maps build", lines) ) {
+        return make_nested_map(str).size();
+    };
+
+    const auto index = ini_index::build(str).get();
+    const auto nested = make_nested_map(str);
+    BENCHMARK( bench_name("ini_index 1000 lookups, sections", sections) ) {
+        size_t found = 0;
+        for (const auto& [section, key] : queries)
+            found += index.find(section, key).has_value();
+        return found;
+    };
+    BENCHMARK( bench_name("map of maps 1000 lookups, sections", sections) ) {
+        size_t found = 0;
+        for (const auto& [section, key] : queries)
+        {
+            const auto s = nested.find(trim_spaces_underscores_andlower(section));
+            found += s != nested.end() && s->second.count(trim_spaces_underscores_andlower(key));
+        }
+        return found;
+    };
+}
+
+TEST_CASE( "Sectioned INI index benchmark" ) {
+    benchmark_ini_index(medium_size);
+}
+
+TEST_CASE( "Sectioned INI index benchmark, large inputs", "[.][large]" ) {
+    benchmark_ini_index(large_size);
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "CliniParser.hpp"
+#include "Generators.hpp"
+
+/**
+ * @brief Former regex based splitter, kept as the baseline of the benchmark
+ * 
+ * @tparam Rng Range container type
+ * @param keyvalue_str char range to split
+ * @return true the range has been split into a key and a value
+ */
+template<range Rng>
+bool regex_split_keyvalue_pair(Rng&& keyvalue_str)
+{
+    const auto& res = keyvalue_str 
+        | views::tokenize(keyvalue_re,{1,2})
+        | views::transform([](auto&& t){
+            return subrange(t.first,t.second);
+        });
+    return distance(res) == 2;
+}
+
+void benchmark_keyvalue_split(size_t size)
+{
+    const std::string ini = make_ini(size);
+    const auto lines = split_token(ini, fileline_re).get();
+
+    BENCHMARK( bench_name("regex keyvalue_re", size) ) {
+        size_t parsed = 0;
+        for (const auto& line : lines)
+            parsed += regex_split_keyvalue_pair(line);
+        return parsed;
+    };
+
+    BENCHMARK( bench_name("split_keyvalue_pair", size) ) {
+        size_t parsed = 0;
+        for (const auto& line : lines)
+            parsed += split_keyvalue_pair(line).is_valid();
+        return parsed;
+    };
+}
+
+TEST_CASE( "Key/Value splitting benchmark" ) {
+    benchmark_keyvalue_split(small_size);
+    benchmark_keyvalue_split(medium_size);
+}
+
+TEST_CASE( "Key/Value splitting benchmark, large inputs", "[.][large]" ) {
+    benchmark_keyvalue_split(large_size);
+    benchmark_keyvalue_split(huge_size);
+}
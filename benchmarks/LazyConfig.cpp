@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "LazyConfig.hpp"
+#include "Generators.hpp"
+
+/**
+ * @brief Eager reference: every value parsed with its type when its line is read
+ *
+ */
+size_t parse_every_value(const std::string& str)
+{
+    size_t parsed = 0;
+    const auto& lines = split_lines(str);
+    for (const auto& line : lines.get())
+    {
+        const auto& kv = split_keyvalue_pair(line);
+        const std::string_view key = ::detail::to_string_view(kv.get().first);
+        if (key.front() == 'I')
+            parsed += simple_parse<long>(kv.get().second).is_valid();
+        else if (key.front() == 'f')
+            parsed += simple_parse<double>(kv.get().second).is_valid();
+        else if (key.front() == 'v')
+            parsed += vector_parse<double>(kv.get().second).is_valid();
+        else
+            parsed += !to<std::string>(kv.get().second).empty();
+    }
+    return parsed;
+}
+
+void benchmark_lazy_config(size_t lines)
+{
+    const std::string str = make_ini(lines);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 100; ++i)
+        keys.push_back("int_parameter" + std::to_string(10 * (i * lines / 1000) + 1));
+
+    BENCHMARK( bench_name("every value parsed", lines) ) {
+        return parse_every_value(str);
+    };
+    BENCHMARK( bench_name("lazy_config, 100 values read", lines) ) {
+        auto config = lazy_config::from_string(str).get();
+        long sum = 0;
+        for (const auto& key : keys)
+            sum += *config.get<long>(key).get();
+        return sum;
+    };
+}
+
+TEST_CASE( "Lazy configuration benchmark" ) {
+    benchmark_lazy_config(medium_size);
+}
+
+TEST_CASE( "Lazy configuration benchmark, large inputs", "[.][large]" ) {
+    benchmark_lazy_config(large_size);
+}
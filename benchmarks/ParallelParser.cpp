@@ -0,0 +1,28 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "ParallelParser.hpp"
+#include "BenchSchema.hpp"
+
+void benchmark_parallel_load(size_t lines)
+{
+    const std::string str = make_schema_ini(lines);
+
+    BENCHMARK( bench_name("schema load", lines) ) {
+        BenchProperties props{};
+        return BenchSchema::load(props, split_lines(str).get()).is_valid();
+    };
+    for (size_t threads : {size_t{1}, size_t{4}, size_t{std::thread::hardware_concurrency()}})
+        BENCHMARK( bench_name("parallel_load " + std::to_string(threads) + " threads", lines) ) {
+            BenchProperties props{};
+            return parallel_load<BenchSchema>(props, str, threads, 1 << 16).is_valid();
+        };
+}
+
+TEST_CASE( "Parallel loading benchmark" ) {
+    benchmark_parallel_load(medium_size);
+}
+
+TEST_CASE( "Parallel loading benchmark, large inputs", "[.][large]" ) {
+    benchmark_parallel_load(large_size);
+    benchmark_parallel_load(huge_size);
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Scanner.hpp"
+#include "Generators.hpp"
+
+const char* level_name(simd_level level)
+{
+    switch (level)
+    {
+    case simd_level::avx2: return "avx2";
+    case simd_level::sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+void benchmark_splitting(size_t bytes)
+{
+    const std::string str = make_ini_bytes(bytes);
+
+    BENCHMARK( bench_bytes_name("split_token fileline_re", bytes) ) {
+        return split_token(str, fileline_re).get().size();
+    };
+    for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2})
+    {
+        if (level > detected_simd_level())
+            continue;
+        BENCHMARK( bench_bytes_name("split_lines " + std::string(level_name(level)), bytes) ) {
+            return scan_tokens<scan_class::line>(str, level).get().size();
+        };
+    }
+    BENCHMARK( bench_bytes_name("split_token commandline_re", bytes) ) {
+        return split_token(str, commandline_re).get().size();
+    };
+    BENCHMARK( bench_bytes_name("split_args", bytes) ) {
+        return split_args(str).get().size();
+    };
+}
+
+TEST_CASE( "Line splitting benchmark, 1MB" ) {
+    benchmark_splitting(megabyte);
+}
+
+TEST_CASE( "Line splitting benchmark, 100MB", "[.][large]" ) {
+    benchmark_splitting(100 * megabyte);
+}
+
+TEST_CASE( "Line splitting benchmark, 1GB", "[.][large]" ) {
+    benchmark_splitting(gigabyte);
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "CliniParser.hpp"
+#include "Generators.hpp"
+
+/**
+ * @brief Benchmark simple_parse<ValueT> over size values fitting in ValueT
+ *
+ * @tparam ValueT arithmetic type
+ * @param type_name
+ * @param size
+ */
+template <class ValueT>
+void benchmark_simple_parse(const std::string& type_name, size_t size)
+{
+    input_rng rng;
+    std::vector<std::string> values;
+    values.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+        if constexpr (std::is_floating_point_v<ValueT>)
+            values.push_back(std::to_string(rng(100000)) + "." + std::to_string(rng(1000)) + "e-2");
+        else if constexpr (std::is_signed_v<ValueT>)
+            values.push_back((i % 2 ? "-" : "") + std::to_string(rng(100)));
+        else
+            values.push_back(std::to_string(rng(200)));
+
+    BENCHMARK( bench_name("simple_parse<" + type_name + ">", size) ) {
+        size_t parsed = 0;
+        for (const auto& value : values)
+            parsed += simple_parse<ValueT>(value).is_valid();
+        return parsed;
+    };
+}
+
+void benchmark_single_values(size_t size)
+{
+    benchmark_simple_parse<short>("short", size);
+    benchmark_simple_parse<unsigned short>("unsigned short", size);
+    benchmark_simple_parse<int>("int", size);
+    benchmark_simple_parse<unsigned>("unsigned", size);
+    benchmark_simple_parse<long>("long", size);
+    benchmark_simple_parse<unsigned long>("unsigned long", size);
+    benchmark_simple_parse<long long>("long long", size);
+    benchmark_simple_parse<unsigned long long>("unsigned long long", size);
+    benchmark_simple_parse<float>("float", size);
+    benchmark_simple_parse<double>("double", size);
+    benchmark_simple_parse<long double>("long double", size);
+}
+
+TEST_CASE( "Single value parsing benchmark" ) {
+    benchmark_single_values(small_size);
+    benchmark_single_values(medium_size);
+}
+
+TEST_CASE( "Single value parsing benchmark, large inputs", "[.][large]" ) {
+    benchmark_single_values(large_size);
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <sstream>
+#include "CliniParser.hpp"
+#include "Arguments.hpp"
+#include "Generators.hpp"
+
+void benchmark_tokenizing(size_t size)
+{
+    const std::string ini = make_ini(size);
+    const std::string commandline = make_commandline(size);
+
+    BENCHMARK( bench_name("split_token fileline_re", size) ) {
+        return split_token(ini, fileline_re).get().size();
+    };
+    BENCHMARK( bench_name("split_token commandline_re", size) ) {
+        return split_token(commandline, commandline_re).get().size();
+    };
+
+    // the same command line as an argv array
+    std::vector<std::string> storage;
+    std::istringstream in(commandline);
+    for (std::string arg; in >> arg;)
+        storage.push_back(arg);
+    std::vector<const char*> argv;
+    for (const auto& arg : storage)
+        argv.push_back(arg.c_str());
+
+    BENCHMARK( bench_name("join argv and split_token commandline_re", size) ) {
+        std::string joined;
+        for (const char* arg : argv)
+            joined.append(arg).push_back(' ');
+        const auto& tokens = split_token(joined, commandline_re);
+        size_t n = 0;
+        for (const auto& token : tokens.get())
+            n += split_keyvalue_pair(token).is_valid();
+        return n;
+    };
+    BENCHMARK( bench_name("for_each_argument", size) ) {
+        size_t n = 0;
+        for_each_argument(argv, [&](std::string_view, std::string_view) { ++n; });
+        return n;
+    };
+}
+
+TEST_CASE( "Tokenizing benchmark" ) {
+    benchmark_tokenizing(small_size);
+    benchmark_tokenizing(medium_size);
+}
+
+TEST_CASE( "Tokenizing benchmark, large inputs", "[.][large]" ) {
+    benchmark_tokenizing(large_size);
+    benchmark_tokenizing(huge_size);
+}
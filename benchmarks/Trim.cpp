@@ -0,0 +1,47 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "TrimLower.hpp"
+#include "Generators.hpp"
+
+void benchmark_trim(size_t size)
+{
+    std::vector<std::string> keys;
+    keys.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+        keys.push_back(" Some_Parameter\tName " + std::to_string(i));
+
+    BENCHMARK( bench_name("trim_spaces_underscores", size) ) {
+        size_t length = 0;
+        for (const auto& key : keys)
+            length += trim_spaces_underscores(key).size();
+        return length;
+    };
+    BENCHMARK( bench_name("str_tolower", size) ) {
+        size_t length = 0;
+        for (const auto& key : keys)
+            length += str_tolower(key).size();
+        return length;
+    };
+    BENCHMARK( bench_name("trim_spaces_underscores_andlower", size) ) {
+        size_t length = 0;
+        for (const auto& key : keys)
+            length += trim_spaces_underscores_andlower(key).size();
+        return length;
+    };
+    BENCHMARK( bench_name("trim_spaces_underscores_andlower locale", size) ) {
+        const std::locale loc;
+        size_t length = 0;
+        for (const auto& key : keys)
+            length += trim_spaces_underscores_andlower(key, loc).size();
+        return length;
+    };
+}
+
+TEST_CASE( "Trim and lowercase benchmark" ) {
+    benchmark_trim(small_size);
+    benchmark_trim(medium_size);
+}
+
+TEST_CASE( "Trim and lowercase benchmark, large inputs", "[.][large]" ) {
+    benchmark_trim(large_size);
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "CliniParser.hpp"
+#include "LazyVector.hpp"
+#include "NumericVector.hpp"
+#include "Generators.hpp"
+
+void benchmark_vector_parsing(size_t size)
+{
+    input_rng rng;
+    std::vector<std::string> short_values;
+    for (size_t i = 0; i < size; ++i)
+        short_values.push_back(make_vector_value(8, rng));
+    const std::string long_value = make_vector_value(size, rng);
+
+    BENCHMARK( bench_name("vector_parse<double> short vectors", size) ) {
+        size_t parsed = 0;
+        for (const auto& value : short_values)
+            parsed += vector_parse<double>(value).get().size();
+        return parsed;
+    };
+    BENCHMARK( bench_name("vector_parse<double> long vector", size) ) {
+        return vector_parse<double>(long_value).get().size();
+    };
+    BENCHMARK( bench_name("vector_parse<float> long vector", size) ) {
+        return vector_parse<float>(long_value).get().size();
+    };
+    BENCHMARK( bench_name("numeric_vector_parse<double> short vectors", size) ) {
+        size_t parsed = 0;
+        for (const auto& value : short_values)
+            parsed += numeric_vector_parse<double>(value).get().size();
+        return parsed;
+    };
+    BENCHMARK( bench_name("numeric_vector_parse<double> long vector", size) ) {
+        return numeric_vector_parse<double>(long_value).get().size();
+    };
+    BENCHMARK( bench_name("numeric_vector_parse<double> long vector, 4 threads", size) ) {
+        return numeric_vector_parse<double>(long_value, 4, 1 << 16).get().size();
+    };
+}
+
+void benchmark_range_parsing(size_t size)
+{
+    std::string spelled_out;
+    for (size_t i = 1; i <= size; ++i)
+        spelled_out += std::to_string(i) + ",";
+    const std::string range = "1:" + std::to_string(size);
+
+    BENCHMARK( bench_name("vector_parse<int> spelled out sweep", size) ) {
+        return vector_parse<int>(spelled_out).get().size();
+    };
+    BENCHMARK( bench_name("lazy_vector_parse<int> range sweep", size) ) {
+        return lazy_vector_parse<int>(range).get().size();
+    };
+    BENCHMARK( bench_name("lazy_vector_parse<int> range sweep, summed", size) ) {
+        const auto sweep = lazy_vector_parse<int>(range).get();
+        long sum = 0;
+        for (int value : sweep)
+            sum += value;
+        return sum;
+    };
+}
+
+TEST_CASE( "Vector parsing benchmark" ) {
+    benchmark_vector_parsing(small_size);
+    benchmark_vector_parsing(medium_size);
+    benchmark_range_parsing(small_size);
+    benchmark_range_parsing(medium_size);
+}
+
+TEST_CASE( "Vector parsing benchmark, large inputs", "[.][large]" ) {
+    benchmark_vector_parsing(large_size);
+    benchmark_vector_parsing(huge_size);
+    benchmark_range_parsing(large_size);
+}
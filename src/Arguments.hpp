@@ -0,0 +1,114 @@
+/**
+ * @file Arguments.hpp
+ * @brief Command line parsing straight from argc/argv, without joining the arguments
+ *
+ * Each argv element is one key=value candidate, split in place: nothing is
+ * allocated, and values may contain spaces. As with split_token, arguments
+ * starting with '#' or '%' are skipped, and so are empty arguments.
+ */
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CliniParser.hpp"
+#include "Schema.hpp"
+
+/**
+ * @brief Arguments of a command line, not owned
+ *
+ */
+using argument_span = std::span<const char* const>;
+
+/**
+ * @brief Error payload: index of the argument in the span and error
+ *
+ */
+using argument_error = std::pair<std::size_t, ParsingErrorsT>;
+
+/**
+ * @brief Arguments of main, the program name skipped
+ *
+ * @param argc
+ * @param argv
+ * @return argument_span
+ */
+inline argument_span arguments(int argc, const char* const* argv)
+{
+    if (argc < 1 || !argv)
+        return {};
+    return {argv + 1, static_cast<std::size_t>(argc - 1)};
+}
+
+/**
+ * @brief Call f(key, value) on the key=value split of every argument
+ *
+ * @tparam F returns void, or expected<void, ParsingErrorsT> to stop at its first error
+ * @param args
+ * @param f
+ * @return expected<void, argument_error> keyvaluenotparsed at the first argument
+ * without a key or a value, or the first error of f
+ */
+template <class F>
+expected<void, argument_error> for_each_argument(argument_span args, F&& f)
+{
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        const std::string_view arg(args[i]);
+        if (arg.empty() || arg.front() == '#' || arg.front() == '%')
+            continue;
+        const auto& kv = split_keyvalue_pair(arg);
+        if (!kv)
+            return expected<void, argument_error>::error(i, kv.error().second);
+        const std::string_view key = ::detail::to_string_view(kv.get().first);
+        const std::string_view value = ::detail::to_string_view(kv.get().second);
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, std::string_view, std::string_view>>)
+            f(key, value);
+        else
+        {
+            const auto& res = f(key, value);
+            if (!res)
+                return expected<void, argument_error>::error(i, res.error());
+        }
+    }
+    return expected<void, argument_error>::success();
+}
+
+/**
+ * @brief Assign every argument to a schema, as Schema::load does with lines
+ *
+ * @tparam Schema schema<...> of the properties
+ * @param props
+ * @param args
+ * @return expected<void, argument_error> stopping at the first argument in error
+ */
+template <class Schema>
+expected<void, argument_error> load_arguments(typename Schema::properties_type& props, argument_span args)
+{
+    return for_each_argument(args, [&](std::string_view key, std::string_view value) {
+        return Schema::assign(props, key, value);
+    });
+}
+
+/**
+ * @brief The arguments as a vector of views, same result as split_token(joined arguments, commandline_re)
+ * for arguments without spaces
+ *
+ * @param args
+ * @return expected_args<std::vector<std::string_view>> empty if there is no argument left
+ */
+inline expected_args<std::vector<std::string_view>> split_arguments(argument_span args)
+{
+    std::vector<std::string_view> res;
+    res.reserve(args.size());
+    for (const char* arg : args)
+        if (arg[0] != '\0' && arg[0] != '#' && arg[0] != '%')
+            res.emplace_back(arg);
+    if (!res.empty())
+        return expected_args<std::vector<std::string_view>>::success(std::move(res));
+    else
+        return expected_args<std::vector<std::string_view>>::error(FileAndArgsErrorsT::empty);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file BatchLoader.hpp
+ * @brief Loading many small configuration files into a schema, on several threads
+ *
+ * The threads take the files by blocks from a shared cursor, so that a thread
+ * slowed down by large files leaves the rest of the list to the others. Every
+ * file of a block is opened and announced to the kernel before the first one
+ * is read, so that the reads of the next files overlap the parsing of the
+ * current one. Each thread reads into the same buffer from one file to the
+ * next, which is only reallocated for a larger file.
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "ParallelParser.hpp"
+
+namespace detail
+{
+    /**
+     * @brief File opened ahead of its read
+     *
+     */
+    class prefetched_file
+    {
+    public:
+        prefetched_file() = default;
+
+        explicit prefetched_file(const std::string& filename)
+        {
+#ifdef CLINIARG_HAS_MMAP
+            m_fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (m_fd < 0)
+                return;
+            struct stat st;
+            if (::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode))
+                m_size = static_cast<std::size_t>(st.st_size);
+#ifdef POSIX_FADV_WILLNEED
+            ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+#else
+            m_file.open(filename, std::ios::binary);
+#endif
+        }
+
+        prefetched_file(const prefetched_file&) = delete;
+        prefetched_file& operator=(const prefetched_file&) = delete;
+
+        prefetched_file(prefetched_file&& other) noexcept { *this = std::move(other); }
+
+        prefetched_file& operator=(prefetched_file&& other) noexcept
+        {
+#ifdef CLINIARG_HAS_MMAP
+            std::swap(m_fd, other.m_fd);
+            std::swap(m_size, other.m_size);
+#else
+            m_file = std::move(other.m_file);
+#endif
+            return *this;
+        }
+
+        ~prefetched_file()
+        {
+#ifdef CLINIARG_HAS_MMAP
+            if (m_fd >= 0)
+                ::close(m_fd);
+#endif
+        }
+
+        /**
+         * @brief Read the whole file into buffer, replacing its content but keeping its capacity
+         *
+         * @param buffer
+         * @return std::optional<FileAndArgsErrorsT> filenotopened, fileioerror
+         */
+        std::optional<FileAndArgsErrorsT> read(std::string& buffer)
+        {
+            const ::detail::stage_timer timer(parse_stage::read);
+            buffer.clear();
+#ifdef CLINIARG_HAS_MMAP
+            if (m_fd < 0)
+                return FileAndArgsErrorsT::filenotopened;
+            // one read for a regular file, read_fd for what is left (pipes, growing files)
+            buffer.resize(m_size);
+            std::size_t done = 0;
+            while (done < m_size)
+            {
+                const ssize_t n = ::read(m_fd, buffer.data() + done, m_size - done);
+                if (n > 0)
+                    done += static_cast<std::size_t>(n);
+                else if (n == 0)
+                    break;
+                else if (errno != EINTR)
+                    return FileAndArgsErrorsT::fileioerror;
+            }
+            buffer.resize(done);
+            if (!::detail::read_fd(m_fd, buffer))
+                return FileAndArgsErrorsT::fileioerror;
+#else
+            if (!m_file)
+                return FileAndArgsErrorsT::filenotopened;
+            ::detail::read_stream(m_file, buffer);
+            if (m_file.bad())
+                return FileAndArgsErrorsT::fileioerror;
+#endif
+            ::detail::count_bytes_read(buffer.size());
+            return std::nullopt;
+        }
+
+    private:
+#ifdef CLINIARG_HAS_MMAP
+        int m_fd = -1;
+        std::size_t m_size = 0;
+#else
+        std::ifstream m_file;
+#endif
+    };
+
+    /**
+     * @brief Load the files of the list until the shared cursor reaches its end
+     *
+     * @tparam Schema
+     * @param filenames
+     * @param defaults
+     * @param cursor index of the next block to take
+     * @param block number of files opened ahead
+     * @param results one slot per file, written once by the thread that loaded it
+     */
+    template <class Schema>
+    void batch_worker(std::span<const std::string> filenames, const typename Schema::properties_type& defaults,
+                      std::atomic<std::size_t>& cursor, std::size_t block,
+                      std::vector<std::optional<expected<typename Schema::properties_type, load_error>>>& results)
+    {
+        using result_t = expected<typename Schema::properties_type, load_error>;
+        std::string buffer;
+        std::vector<prefetched_file> files(block);
+        for (;;)
+        {
+            const std::size_t first = cursor.fetch_add(block, std::memory_order_relaxed);
+            if (first >= filenames.size())
+                return;
+            const std::size_t last = std::min(first + block, filenames.size());
+            for (std::size_t i = first; i < last; ++i)
+                files[i - first] = prefetched_file(filenames[i]);
+
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const auto& error = files[i - first].read(buffer);
+                files[i - first] = prefetched_file();
+                if (error)
+                {
+                    results[i].emplace(result_t::error(*error));
+                    continue;
+                }
+                auto chunk = parse_chunk<Schema>(buffer, 0, buffer.size());
+                if (chunk.error)
+                {
+                    results[i].emplace(result_t::error(*chunk.error));
+                    continue;
+                }
+                auto props = defaults;
+                Schema::merge(props, chunk.props, chunk.assigned);
+                results[i].emplace(result_t::success(std::move(props)));
+            }
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Load every file into a copy of defaults, on several threads
+ *
+ * Each file gives the result of Schema::load on its lines, the keys it does
+ * not set keeping their default value, or its own error: a file that cannot
+ * be read or parsed does not stop the others.
+ *
+ * As parallel_load, every call starts its threads with std::async and joins
+ * them before returning; no pool is kept from one call to the next. Starting
+ * a thread costs far more than parsing a small file, so the files are best
+ * given in one call rather than a few at a time.
+ *
+ * @tparam Schema schema<...> of the properties
+ * @param filenames
+ * @param defaults
+ * @param threads maximum number of threads, the calling one included
+ * @param block number of files a thread takes and opens ahead at once
+ * @return std::vector<expected<properties_type, load_error>> in the order of filenames
+ */
+template <class Schema>
+std::vector<expected<typename Schema::properties_type, load_error>>
+batch_load(std::span<const std::string> filenames, const typename Schema::properties_type& defaults = {},
+           std::size_t threads = std::thread::hardware_concurrency(), std::size_t block = 8)
+{
+    using result_t = expected<typename Schema::properties_type, load_error>;
+    block = std::max<std::size_t>(block, 1);
+    const std::size_t workers = std::clamp<std::size_t>((filenames.size() + block - 1) / block, 1, std::max<std::size_t>(threads, 1));
+
+    std::vector<std::optional<result_t>> slots(filenames.size());
+    std::atomic<std::size_t> cursor{0};
+    std::vector<std::future<void>> pending;
+    for (std::size_t w = 1; w < workers; ++w)
+        pending.push_back(std::async(std::launch::async, [&] {
+            ::detail::batch_worker<Schema>(filenames, defaults, cursor, block, slots);
+        }));
+    ::detail::batch_worker<Schema>(filenames, defaults, cursor, block, slots);
+    for (auto& p : pending)
+        p.get();
+
+    std::vector<result_t> res;
+    res.reserve(slots.size());
+    for (auto& slot : slots)
+        res.push_back(std::move(*slot));
+    return res;
+}
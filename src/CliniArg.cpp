@@ -0,0 +1,83 @@
+/**
+ * @file CliniArg.cpp
+ * @brief The cliniarg library: CliniArg.hpp definitions and the explicit
+ * instantiations declared by CliniParser.hpp under CLINIARG_EXTERN_TEMPLATES
+ *
+ */
+#include "CliniArg.hpp"
+#include "CliniParser.hpp"
+#include "Scanner.hpp"
+#include "Schema.hpp"
+#include "TrimLower.hpp"
+
+#define CLINIARG_INSTANTIATE_RANGES(F, T, ...) \
+    template __VA_ARGS__ F<T, std::string>(std::string&&); \
+    template __VA_ARGS__ F<T, std::string&>(std::string&); \
+    template __VA_ARGS__ F<T, const std::string&>(const std::string&); \
+    template __VA_ARGS__ F<T, std::string_view>(std::string_view&&); \
+    template __VA_ARGS__ F<T, std::string_view&>(std::string_view&); \
+    template __VA_ARGS__ F<T, const std::string_view&>(const std::string_view&);
+
+#define CLINIARG_INSTANTIATE_PARSE(T) \
+    CLINIARG_INSTANTIATE_RANGES(simple_parse, T, expected<T, ParsingErrorsT>) \
+    CLINIARG_INSTANTIATE_RANGES(vector_parse, T, expected_vector<T>) \
+    template expected<T, ParsingErrorsT> parse_value<T>(std::string_view); \
+    template expected<std::vector<T>, ParsingErrorsT> parse_vector<T>(std::string_view);
+
+template <class ValueT>
+expected<ValueT, ParsingErrorsT> parse_value(std::string_view value)
+{
+    return simple_parse<ValueT>(value);
+}
+
+template <class ValueT>
+expected<std::vector<ValueT>, ParsingErrorsT> parse_vector(std::string_view value)
+{
+    return vector_parse<ValueT>(value);
+}
+
+CLINIARG_PARSE_TYPES(CLINIARG_INSTANTIATE_PARSE)
+
+namespace
+{
+    expected<std::vector<std::string_view>, FileAndArgsErrorsT> views_of(const auto& tokens)
+    {
+        using result_t = expected<std::vector<std::string_view>, FileAndArgsErrorsT>;
+        if (!tokens)
+            return result_t::error(tokens.error());
+        std::vector<std::string_view> res;
+        res.reserve(tokens.get().size());
+        for (const auto& token : tokens.get())
+            res.push_back(::detail::to_string_view(token));
+        return result_t::success(std::move(res));
+    }
+} // namespace
+
+expected<std::string, FileAndArgsErrorsT> read_file(const std::string& filename)
+{
+    return get_file(filename);
+}
+
+expected<std::vector<std::string_view>, FileAndArgsErrorsT> tokenize_lines(std::string_view str)
+{
+    return views_of(split_lines(str));
+}
+
+expected<std::vector<std::string_view>, FileAndArgsErrorsT> tokenize_args(std::string_view str)
+{
+    return views_of(split_args(str));
+}
+
+expected<std::pair<std::string_view, std::string_view>, ParsingErrorsT> split_keyvalue(std::string_view str)
+{
+    using result_t = expected<std::pair<std::string_view, std::string_view>, ParsingErrorsT>;
+    const auto& kv = split_keyvalue_pair(str);
+    if (!kv)
+        return result_t::error(kv.error().second);
+    return result_t::success(::detail::to_string_view(kv.get().first), ::detail::to_string_view(kv.get().second));
+}
+
+std::string normalize_key(std::string key)
+{
+    return trim_spaces_underscores_andlower(std::move(key));
+}
@@ -0,0 +1,86 @@
+/**
+ * @file CliniArg.hpp
+ * @brief Interface of the compiled cliniarg library
+ *
+ * Includes neither range-v3 nor <regex>: the parsing code is compiled once in
+ * the library (src/CliniArg.cpp), which holds the explicit instantiations for
+ * the types of CLINIARG_PARSE_TYPES. Translation units which only parse values,
+ * split lines and read files can include this header instead of CliniParser.hpp.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Errors.hpp"
+#include "Expected.hpp"
+
+/**
+ * @brief Types instantiated in the library, X(type) for each one
+ *
+ */
+#define CLINIARG_PARSE_TYPES(X) \
+    X(bool) X(char) X(signed char) X(unsigned char) \
+    X(short) X(unsigned short) X(int) X(unsigned int) \
+    X(long) X(unsigned long) X(long long) X(unsigned long long) \
+    X(float) X(double) X(long double)
+
+/**
+ * @brief simple_parse<ValueT>(value)
+ *
+ * @tparam ValueT one of CLINIARG_PARSE_TYPES
+ * @param value
+ * @return expected<ValueT, ParsingErrorsT>
+ */
+template <class ValueT>
+expected<ValueT, ParsingErrorsT> parse_value(std::string_view value);
+
+/**
+ * @brief vector_parse<ValueT>(value)
+ *
+ * @tparam ValueT one of CLINIARG_PARSE_TYPES
+ * @param value
+ * @return expected<std::vector<ValueT>, ParsingErrorsT>
+ */
+template <class ValueT>
+expected<std::vector<ValueT>, ParsingErrorsT> parse_vector(std::string_view value);
+
+#define CLINIARG_DECLARE_PARSE(T) \
+    extern template expected<T, ParsingErrorsT> parse_value<T>(std::string_view); \
+    extern template expected<std::vector<T>, ParsingErrorsT> parse_vector<T>(std::string_view);
+CLINIARG_PARSE_TYPES(CLINIARG_DECLARE_PARSE)
+#undef CLINIARG_DECLARE_PARSE
+
+/**
+ * @brief get_file(filename)
+ *
+ */
+expected<std::string, FileAndArgsErrorsT> read_file(const std::string& filename);
+
+/**
+ * @brief split_lines(str), as views
+ *
+ * @return expected<std::vector<std::string_view>, FileAndArgsErrorsT> empty if there is no line left
+ */
+expected<std::vector<std::string_view>, FileAndArgsErrorsT> tokenize_lines(std::string_view str);
+
+/**
+ * @brief split_args(str), as views
+ *
+ * @return expected<std::vector<std::string_view>, FileAndArgsErrorsT> empty if there is no argument left
+ */
+expected<std::vector<std::string_view>, FileAndArgsErrorsT> tokenize_args(std::string_view str);
+
+/**
+ * @brief split_keyvalue_pair(str), as views
+ *
+ * @return expected<std::pair<std::string_view, std::string_view>, ParsingErrorsT> keyvaluenotparsed
+ */
+expected<std::pair<std::string_view, std::string_view>, ParsingErrorsT> split_keyvalue(std::string_view str);
+
+/**
+ * @brief trim_spaces_underscores_andlower(key)
+ *
+ */
+std::string normalize_key(std::string key);
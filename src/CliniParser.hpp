@@ -10,40 +10,39 @@
  */
 #pragma once
 #include <regex>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <charconv>
+#include <cctype>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
 
+#include "Errors.hpp"
 #include "Expected.hpp"
+#include "Instrumentation.hpp"
 #include <range/v3/all.hpp>
 
 using namespace ranges;
 
 
-/**
- * @brief Various error related to parsing, kept in one enum
- * 
- */
-enum ParsingErrorsT
-{
-    keyvaluenotparsed,
-    keynotfound,
-    valuenotparsed,
-    emptyvector,
-    vectorvaluenotparsed
-};
-
 /**
  * @brief Error payload with relative position
  * 
  */
 template <range Rng>
-using ParsingErrorWithPositionT = const std::pair<iterator_t<Rng>,ParsingErrorsT>;
+using ParsingErrorWithPositionT = std::pair<iterator_t<Rng>,ParsingErrorsT>;
 
 /**
- * @brief Regex for key value split
+ * @brief Regex for key value split, reference grammar of split_keyvalue_pair
  * 
  */
-const std::regex keyvalue_re(R"#(^([^=]+)=(.+)$)#");
+inline const std::regex keyvalue_re(R"#(^([^=]+)=(.+)$)#");
 
 /**
  * @brief Expected key-value pair
@@ -51,34 +50,40 @@ const std::regex keyvalue_re(R"#(^([^=]+)=(.+)$)#");
  * @tparam Rng Range container type 
  */
 template <range Rng>
-using expected_keyvalue_pair = expected<std::pair<range_value_t<Rng>,range_value_t<Rng>>, // Payload
+using expected_keyvalue_pair = expected<std::pair<subrange<iterator_t<Rng>>,subrange<iterator_t<Rng>>>, // Payload
                  ParsingErrorWithPositionT<Rng>>; // Eventual error
 
 /**
  * @brief Split a "foo=bar" char range into left and right subranges "foo" and "bar"
  * 
+ * Single pass equivalent of keyvalue_re: the first '=' splits the range, both
+ * sides must be non-empty and the value may not contain a line break.
+ * 
  * @tparam Rng Hange container type
  * @param keyvalue_str char range to split
- * @return const auto return a pair of subrange
+ * @return auto return a pair of subrange, or the start of the range on failure
  */
 template<range Rng>
-const auto split_keyvalue_pair(Rng&& keyvalue_str)
+auto split_keyvalue_pair(Rng&& keyvalue_str)
 {
-    const auto& res = keyvalue_str 
-        | views::tokenize(keyvalue_re,{1,2})
-        | views::move
-        | views::transform([](auto&& t){
-            return subrange(t.first,t.second);
-        });
-
-    if (distance(res) == 2)
-    {                     // successful parsing
-        return expected_keyvalue_pair<decltype(res)>::success(*begin(res),*next(begin(res)));
-    }
-    else
-    { // Failed parsing
-        return expected_keyvalue_pair<decltype(res)>::error(std::make_pair(*begin(res),ParsingErrorsT::keyvaluenotparsed));
-    }
+    return ::detail::instrument(parse_stage::split_keyvalue, [&] {
+        const iterator_t<Rng> first = begin(keyvalue_str);
+        const iterator_t<Rng> last = next(first, end(keyvalue_str));
+
+        const auto equal = std::find(first, last, '=');
+        if (equal != first && equal != last)
+        {
+            const auto value_first = std::next(equal);
+            if (value_first != last
+                && std::find_if(value_first, last, [](char c){ return c == '\n' || c == '\r'; }) == last)
+            {                     // successful parsing
+                ::detail::count_keys(1);
+                return expected_keyvalue_pair<Rng>::success(subrange(first,equal),subrange(value_first,last));
+            }
+        }
+        // Failed parsing
+        return expected_keyvalue_pair<Rng>::error(first,ParsingErrorsT::keyvaluenotparsed);
+    });
 }
 
 /**
@@ -91,39 +96,177 @@ const auto split_keyvalue_pair(Rng&& keyvalue_str)
  */
 template <class ValueT>
 bool is_negative_integral(const std::string& value_str) {
-    if constexpr (std::is_unsigned_v<ValueT>){
+    if constexpr (std::is_unsigned_v<ValueT> && !std::is_same_v<ValueT, bool>){
         std::make_signed_t<ValueT> n;
         std::stringstream ststr(value_str);
         return (ststr >> n) && n < 0;
     } else return false;
 }   
 
+namespace detail
+{
+    /**
+     * @brief Arithmetic types handled by std::from_chars, characters and bool keep the stream semantics
+     * 
+     * @tparam ValueT 
+     */
+    template <class ValueT>
+    concept from_chars_arithmetic = std::is_arithmetic_v<ValueT>
+        && !std::is_same_v<ValueT, bool>
+        && !std::is_same_v<ValueT, char> && !std::is_same_v<ValueT, signed char> && !std::is_same_v<ValueT, unsigned char>
+        && !std::is_same_v<ValueT, wchar_t> && !std::is_same_v<ValueT, char8_t>
+        && !std::is_same_v<ValueT, char16_t> && !std::is_same_v<ValueT, char32_t>
+#ifndef __cpp_lib_to_chars // no floating point std::from_chars in this standard library
+        && std::is_integral_v<ValueT>
+#endif
+        ;
+
+    /**
+     * @brief Whether a decimal number, without its sign, is below 1
+     *
+     * Tells an underflow from an overflow when std::from_chars reports a
+     * floating value out of range.
+     *
+     * @param first start of the digits
+     * @param last end of the number
+     */
+    inline bool is_decimal_below_one(const char* first, const char* last)
+    {
+        long scale = 0; // the value is below 10^scale
+        bool significant = false;
+        bool fraction = false;
+        for (; first != last && (std::isdigit(static_cast<unsigned char>(*first)) || (*first == '.' && !fraction)); ++first)
+        {
+            if (*first == '.')
+                fraction = true;
+            else if (significant || *first != '0')
+            {
+                significant = true;
+                scale += !fraction;
+            }
+            else
+                scale -= fraction; // leading zero of the fraction
+        }
+        if (first != last && (*first == 'e' || *first == 'E'))
+        {
+            ++first;
+            const bool exponent_negative = first != last && *first == '-';
+            first += first != last && (*first == '-' || *first == '+');
+            long exponent = 0;
+            for (; first != last && std::isdigit(static_cast<unsigned char>(*first)); ++first)
+                exponent = std::min(exponent * 10 + (*first - '0'), 100000L);
+            scale += exponent_negative ? -exponent : exponent;
+        }
+        return scale <= 0;
+    }
+
+    /**
+     * @brief Parse a char buffer with std::from_chars, following the std::stringstream rules:
+     * leading spaces and an explicit '+' are skipped, the whole buffer must be consumed,
+     * an unsigned type rejects negative values and a floating type rejects inf/nan.
+     * A floating value too small for ValueT is a zero of its sign, a too large one an error.
+     * 
+     * @tparam ValueT type to parse
+     * @param first start of the buffer
+     * @param last end of the buffer
+     * @return expected<ValueT, ParsingErrorsT> 
+     */
+    template <class ValueT>
+    expected<ValueT, ParsingErrorsT> from_chars_parse(const char* first, const char* last)
+    {
+        while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+            ++first;
+        const bool positive = first != last && *first == '+';
+        if (positive)
+            ++first;
+
+        const bool negative = !positive && first != last && *first == '-';
+        const char* digits = negative ? first + 1 : first;
+        if (digits == last || !(std::isdigit(static_cast<unsigned char>(*digits)) || *digits == '.'))
+            return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::valuenotparsed);
+
+        ValueT n;
+        std::from_chars_result res;
+        if constexpr (std::is_unsigned_v<ValueT>)
+            res = std::from_chars(digits, last, n);  // "-0" is the only negative accepted
+        else
+            res = std::from_chars(first, last, n);
+
+        if (res.ec == std::errc{} // parsed and in range
+            && res.ptr == last  // no residual (ex: parse 3.5 into 3)
+            && (!std::is_unsigned_v<ValueT> || !negative || n == 0)) // check for positive if unsigned type
+        { // successful
+            return expected<ValueT, ParsingErrorsT>::success(n);
+        }
+        else if (std::is_floating_point_v<ValueT> && res.ec == std::errc::result_out_of_range && res.ptr == last
+                 && is_decimal_below_one(digits, last))
+        { // underflow: rounded to zero, as the stream does
+            return expected<ValueT, ParsingErrorsT>::success(negative ? -ValueT{0} : ValueT{0});
+        }
+        else
+        { // fail
+            return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::valuenotparsed);
+        }
+    }
+
+    /**
+     * @brief Parse a string with std::stringstream, for any type providing operator>>
+     * 
+     * @tparam ValueT type to parse
+     * @param str_proxy 
+     * @return expected<ValueT, ParsingErrorsT> 
+     */
+    template <class ValueT>
+    expected<ValueT, ParsingErrorsT> stream_parse(const std::string& str_proxy)
+    {
+        std::stringstream ststr(str_proxy);
+
+        ValueT n;
+
+        if (!is_negative_integral<ValueT>(str_proxy) // check for positive if unsigned type
+            && ststr >> n  // parse and return true if parsed
+            && ststr.eof()) // no residual (ex: parse 3.5 into 3)
+        { // successful
+            return expected<ValueT, ParsingErrorsT>::success(n);
+        }
+        else
+        { // fail
+            return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::valuenotparsed);
+        }
+    }
+} // namespace detail
+
 /**
- * @brief Simple parsing function, using provided std::stringstream parser, should cover all base types
+ * @brief Simple parsing function, should cover all base types
+ * 
+ * Arithmetic types are parsed in place with std::from_chars when the range is a
+ * contiguous char range, other types go through std::stringstream.
  * 
  * @tparam ValueT type to parse
  * @tparam Rng Range container
  * @param value_str original string
- * @return const auto 
+ * @return expected<ValueT, ParsingErrorsT>
  */
 template<class ValueT, range Rng>
-const auto simple_parse(Rng&& value_str)
+expected<ValueT, ParsingErrorsT> simple_parse(Rng&& value_str)
 {
-    const std::string& str_proxy{begin(value_str),end(value_str)}; 
-    std::stringstream ststr(str_proxy);
-
-    ValueT n;
-
-    if (!is_negative_integral<ValueT>(str_proxy) // check for positive if unsigned type
-        && ststr >> n  // parse and return true if parsed
-        && ststr.eof()) // no residual (ex: parse 3.5 into 3)
-    { // successful
-        return expected<ValueT, ParsingErrorsT>::success(n);
-    }
-    else
-    { // fail
-        return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::valuenotparsed);
-    }
+    return ::detail::instrument(parse_stage::parse_value, [&]() -> expected<ValueT, ParsingErrorsT> {
+        if constexpr (::detail::from_chars_arithmetic<ValueT>)
+        {
+            if constexpr (contiguous_range<Rng> && std::is_same_v<std::remove_cv_t<range_value_t<Rng>>, char>)
+            {
+                const char* first = data(value_str);
+                return ::detail::from_chars_parse<ValueT>(first, first + distance(value_str));
+            }
+            else
+            {
+                const std::string& str_proxy{begin(value_str),end(value_str)};
+                return ::detail::from_chars_parse<ValueT>(str_proxy.data(), str_proxy.data() + str_proxy.size());
+            }
+        }
+        else
+            return ::detail::stream_parse<ValueT>({begin(value_str),end(value_str)});
+    });
 }
 
 
@@ -135,86 +278,493 @@ const auto simple_parse(Rng&& value_str)
 template <class ValueT>
 using expected_vector = expected<std::vector<ValueT>, ParsingErrorsT>;
 
-const std::regex vector_re{R"#([^,]+)#"};
 /**
- * @brief Apply simple_parse on vector_parse
+ * @brief Regex for vector elements, reference grammar of vector_parse
+ * 
+ */
+inline const std::regex vector_re{R"#([^,]+)#"};
+/**
+ * @brief Apply simple_parse on every comma separated element
+ * 
+ * Single pass: empty elements are skipped (as with vector_re) and parsing stops
+ * at the first element in error.
  * 
  * @tparam ValueT the expected type to parse
  * @param value_str 
  * @return expected_vector<ValueT>
  */
 template<class ValueT, range Rng>
-const auto vector_parse(Rng&& value_str)
+expected_vector<ValueT> vector_parse(Rng&& value_str)
 {
-    const auto& res_token = value_str
-        | views::tokenize(vector_re)
-        | views::transform([](auto&& t){
-            return subrange(t.first,t.second);
-        });
-    typedef range_value_t<decltype(res_token)> sub_range_it; 
-    const auto& res = res_token
-        | views::transform(simple_parse<ValueT, sub_range_it>);
-    if (distance(res) > 0)
-    {
-        bool parsed = accumulate(
-                res | views::transform([](auto&& e) { return e.is_valid(); }), 
-                true,
-                std::logical_and());
-        if (parsed)
+    return ::detail::instrument(parse_stage::parse_value, [&]() -> expected_vector<ValueT> {
+        const iterator_t<Rng> first = begin(value_str);
+        const iterator_t<Rng> last = next(first, end(value_str));
+
+        std::vector<ValueT> vres;
+        vres.reserve(std::count(first, last, ',') + 1);
+        ::detail::count_allocation();
+        for (auto token_first = first; token_first != last;)
         {
-            const auto& vres = res 
-                | views::transform([](auto&& e) { return e.get(); }) 
-                | to_vector;
+            const auto token_last = std::find(token_first, last, ',');
+            if (token_first != token_last)
+            {
+                auto res = simple_parse<ValueT>(subrange(token_first, token_last));
+                if (!res)
+                    return expected_vector<ValueT>::error(ParsingErrorsT::vectorvaluenotparsed);
+                vres.push_back(std::move(res.get()));
+            }
+            token_first = token_last == last ? last : std::next(token_last);
+        }
+
+        if (!vres.empty())
             return expected_vector<ValueT>::success(std::move(vres));
-        } else {
-            return expected_vector<ValueT>::error(ParsingErrorsT::vectorvaluenotparsed);
+        else
+            return expected_vector<ValueT>::error(ParsingErrorsT::emptyvector);
+    });
+}
+
+/**
+ * @brief Result of a constant evaluation parser: value, or error
+ * 
+ * Literal type, usable where expected is not (constexpr and consteval code).
+ * 
+ * @tparam ValueT 
+ */
+template <class ValueT>
+struct constant_parsed
+{
+    ValueT value{};
+    ParsingErrorsT error = ParsingErrorsT::valuenotparsed;
+    bool valid = false;
+
+    constexpr explicit operator bool() const { return valid; }
+
+    static constexpr constant_parsed success(ValueT value) { return {value, {}, true}; }
+    static constexpr constant_parsed failure(ParsingErrorsT error) { return {ValueT{}, error, false}; }
+};
+
+namespace detail
+{
+    constexpr bool constant_isspace(char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+    }
+
+    constexpr bool constant_isdigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief Integral part of constant_parse: same rules as from_chars_parse
+     * 
+     */
+    template <class ValueT>
+    constexpr constant_parsed<ValueT> constant_parse_integral(std::string_view str)
+    {
+        using result_t = constant_parsed<ValueT>;
+        std::size_t i = 0;
+        while (i < str.size() && constant_isspace(str[i]))
+            ++i;
+        const bool positive = i < str.size() && str[i] == '+';
+        const bool negative = !positive && i < str.size() && str[i] == '-';
+        i += positive || negative;
+        if (i == str.size() || !constant_isdigit(str[i]))
+            return result_t::failure(ParsingErrorsT::valuenotparsed);
+
+        using unsigned_type = std::make_unsigned_t<ValueT>;
+        const unsigned_type limit = negative && std::is_signed_v<ValueT>
+            ? static_cast<unsigned_type>(static_cast<unsigned_type>(std::numeric_limits<ValueT>::max()) + 1)
+            : static_cast<unsigned_type>(std::numeric_limits<ValueT>::max());
+        unsigned_type n = 0;
+        for (; i < str.size() && constant_isdigit(str[i]); ++i)
+        {
+            const unsigned_type digit = static_cast<unsigned_type>(str[i] - '0');
+            if (n > (limit - digit) / 10)
+                return result_t::failure(ParsingErrorsT::valuenotparsed); // out of range
+            n = static_cast<unsigned_type>(n * 10 + digit);
         }
+        if (i != str.size() || (std::is_unsigned_v<ValueT> && negative && n != 0))
+            return result_t::failure(ParsingErrorsT::valuenotparsed);
+        return result_t::success(negative ? static_cast<ValueT>(unsigned_type{0} - n) : static_cast<ValueT>(n));
     }
+
+    /**
+     * @brief Unsigned integer of up to 4096 bits, for the exact path of constant_parse_floating
+     *
+     * Large enough for 801 significant digits over the power of ten of the
+     * smallest double, both shifted by the precision of the result.
+     */
+    struct constant_bigint
+    {
+        static constexpr std::size_t capacity = 128;
+        std::array<std::uint32_t, capacity> limbs{};
+        std::size_t size = 0; // limbs in use, the last one non zero
+
+        constexpr void multiply_add(std::uint32_t factor, std::uint32_t addend)
+        {
+            std::uint64_t carry = addend;
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                carry += std::uint64_t{limbs[k]} * factor;
+                limbs[k] = static_cast<std::uint32_t>(carry);
+                carry >>= 32;
+            }
+            if (carry)
+                limbs[size++] = static_cast<std::uint32_t>(carry);
+        }
+
+        constexpr void multiply_pow10(long n)
+        {
+            for (; n >= 9; n -= 9)
+                multiply_add(1000000000, 0);
+            for (; n > 0; --n)
+                multiply_add(10, 0);
+        }
+
+        constexpr void shift_left(std::size_t bits)
+        {
+            if (size == 0)
+                return;
+            const std::size_t words = bits / 32;
+            const unsigned rest = bits % 32;
+            const std::size_t new_size = size + words + 1;
+            for (std::size_t k = new_size; k-- > words;)
+            {
+                const std::size_t from = k - words;
+                std::uint32_t limb = from < size ? limbs[from] << rest : 0;
+                if (rest && from > 0 && from <= size)
+                    limb |= limbs[from - 1] >> (32 - rest);
+                limbs[k] = limb;
+            }
+            for (std::size_t k = 0; k < words; ++k)
+                limbs[k] = 0;
+            size = new_size;
+            while (size > 0 && limbs[size - 1] == 0)
+                --size;
+        }
+
+        /**
+         * @brief Subtract other, not greater than *this
+         *
+         */
+        constexpr void subtract(const constant_bigint& other)
+        {
+            std::uint32_t borrow = 0;
+            for (std::size_t k = 0; k < size; ++k)
+            {
+                const std::uint64_t sub = std::uint64_t{k < other.size ? other.limbs[k] : 0u} + borrow;
+                borrow = limbs[k] < sub;
+                limbs[k] = static_cast<std::uint32_t>(limbs[k] - sub);
+            }
+            while (size > 0 && limbs[size - 1] == 0)
+                --size;
+        }
+
+        constexpr std::size_t bit_length() const
+        {
+            return size == 0 ? 0 : (size - 1) * 32 + static_cast<std::size_t>(std::bit_width(limbs[size - 1]));
+        }
+
+        constexpr friend std::strong_ordering operator<=>(const constant_bigint& a, const constant_bigint& b)
+        {
+            if (a.size != b.size)
+                return a.size <=> b.size;
+            for (std::size_t k = a.size; k-- > 0;)
+                if (a.limbs[k] != b.limbs[k])
+                    return a.limbs[k] <=> b.limbs[k];
+            return std::strong_ordering::equal;
+        }
+    };
+
+    /**
+     * @brief Floating part of constant_parse: same grammar and result as from_chars_parse
+     * 
+     * The result is correctly rounded (to nearest, ties to even), the digits
+     * beyond the 800th only counting for whether they are all zeros. Values
+     * that round beyond max() are errors and those that round to zero are a
+     * zero of their sign, as for from_chars_parse.
+     * Small cases are computed directly in ValueT, where both the digits and
+     * the power of ten are exact; the others divide big integers.
+     * 
+     */
+    template <class ValueT>
+    constexpr constant_parsed<ValueT> constant_parse_floating(std::string_view str)
+    {
+        using limits = std::numeric_limits<ValueT>;
+        static_assert(limits::radix == 2 && limits::digits <= 53 && limits::max_exponent <= 1024,
+                      "constant_parse handles float and double, not wider floating types");
+        using result_t = constant_parsed<ValueT>;
+        std::size_t i = 0;
+        while (i < str.size() && constant_isspace(str[i]))
+            ++i;
+        const bool positive = i < str.size() && str[i] == '+';
+        const bool negative = !positive && i < str.size() && str[i] == '-';
+        i += positive || negative;
+        if (i == str.size() || !(constant_isdigit(str[i]) || str[i] == '.'))
+            return result_t::failure(ParsingErrorsT::valuenotparsed);
+
+        constexpr long max_digits = 800; // more than enough to round any double
+        constant_bigint mantissa;
+        std::uint32_t chunk = 0, chunk_scale = 1; // digits not yet in mantissa
+        long digits = 0;
+        long exponent = 0;
+        bool any_digit = false;
+        bool truncated = false;
+        const auto digit = [&](char c, bool fraction) {
+            any_digit = true;
+            if (digits == 0 && c == '0')
+                exponent -= fraction;
+            else if (digits < max_digits)
+            {
+                chunk = chunk * 10 + static_cast<std::uint32_t>(c - '0');
+                chunk_scale *= 10;
+                if (chunk_scale == 1000000000)
+                {
+                    mantissa.multiply_add(chunk_scale, chunk);
+                    chunk = 0;
+                    chunk_scale = 1;
+                }
+                ++digits;
+                exponent -= fraction;
+            }
+            else
+            {
+                exponent += !fraction;
+                truncated |= c != '0';
+            }
+        };
+        for (; i < str.size() && constant_isdigit(str[i]); ++i)
+            digit(str[i], false);
+        if (i < str.size() && str[i] == '.')
+            for (++i; i < str.size() && constant_isdigit(str[i]); ++i)
+                digit(str[i], true);
+        if (!any_digit)
+            return result_t::failure(ParsingErrorsT::valuenotparsed);
+        if (i < str.size() && (str[i] == 'e' || str[i] == 'E'))
+        {
+            std::size_t j = i + 1;
+            const bool exponent_negative = j < str.size() && str[j] == '-';
+            j += j < str.size() && (str[j] == '-' || str[j] == '+');
+            if (j == str.size() || !constant_isdigit(str[j]))
+                return result_t::failure(ParsingErrorsT::valuenotparsed); // from_chars stops before the 'e'
+            long e = 0;
+            for (; j < str.size() && constant_isdigit(str[j]); ++j)
+                e = std::min(e * 10 + (str[j] - '0'), 100000L);
+            exponent += exponent_negative ? -e : e;
+            i = j;
+        }
+        if (i != str.size())
+            return result_t::failure(ParsingErrorsT::valuenotparsed);
+        if (digits == 0)
+            return result_t::success(negative ? -ValueT{0} : ValueT{0});
+        if (chunk_scale > 1)
+            mantissa.multiply_add(chunk_scale, chunk);
+        if (truncated)
+        { // a trailing non zero digit keeps the rounding of the dropped ones
+            mantissa.multiply_add(10, 1);
+            ++digits;
+            --exponent;
+        }
+
+        // the value is within [10^(digits + exponent - 1), 10^(digits + exponent))
+        if (digits + exponent - 1 > limits::max_exponent10)
+            return result_t::failure(ParsingErrorsT::valuenotparsed); // overflow
+        const auto apply_sign = [&](ValueT x) { return result_t::success(negative ? -x : x); };
+        if (digits + exponent <= limits::min_exponent10 - limits::digits10 - 3)
+            return apply_sign(0); // below denorm_min() / 2: underflow to zero
+
+        constexpr int precision = limits::digits;
+        constexpr long exact_pow10 = precision == 24 ? 10 : 22; // 5^n < 2^precision
+        if (mantissa.bit_length() <= precision && exponent >= -exact_pow10 && exponent <= exact_pow10)
+        { // exact operands: the only rounding is the one of the final operation
+            const ValueT m = static_cast<ValueT>(std::uint64_t{mantissa.limbs[0]} | (mantissa.size > 1 ? std::uint64_t{mantissa.limbs[1]} << 32 : 0));
+            ValueT power = 1;
+            for (long k = 0; k < (exponent < 0 ? -exponent : exponent); ++k)
+                power *= 10;
+            return apply_sign(exponent < 0 ? m / power : m * power);
+        }
+
+        // value = numerator / denominator = q * 2^-shift, q of precision bits, rounded to nearest even
+        constant_bigint numerator = mantissa, denominator;
+        denominator.multiply_add(1, 1);
+        if (exponent > 0)
+            numerator.multiply_pow10(exponent);
+        else
+            denominator.multiply_pow10(-exponent);
+        const auto divide = [&](long shift) {
+            constant_bigint rest = numerator, divisor = denominator;
+            if (shift >= 0)
+                rest.shift_left(static_cast<std::size_t>(shift));
+            else
+                divisor.shift_left(static_cast<std::size_t>(-shift));
+            std::uint64_t q = 0;
+            for (int bit = precision + 1; bit >= 0; --bit)
+            {
+                constant_bigint part = divisor;
+                part.shift_left(static_cast<std::size_t>(bit));
+                if (rest >= part)
+                {
+                    rest.subtract(part);
+                    q |= std::uint64_t{1} << bit;
+                }
+            }
+            rest.shift_left(1);
+            return std::pair{q, rest <=> divisor}; // remainder against half the divisor
+        };
+
+        constexpr long lowest_bit = limits::min_exponent - precision; // exponent of denorm_min()
+        long shift = precision - static_cast<long>(numerator.bit_length()) + static_cast<long>(denominator.bit_length());
+        if (-shift < lowest_bit)
+            shift = -lowest_bit; // subnormal: fewer bits
+        auto quotient = divide(shift);
+        if (quotient.first >> precision)
+            quotient = divide(--shift);
+        auto [q, half] = quotient;
+        if (half > 0 || (half == 0 && (q & 1)))
+            ++q;
+        if (q >> precision)
+        {
+            q >>= 1;
+            --shift;
+        }
+        if (q == 0)
+            return apply_sign(0); // underflow
+        if (-shift > limits::max_exponent - precision)
+            return result_t::failure(ParsingErrorsT::valuenotparsed); // beyond max()
+
+        ValueT x = static_cast<ValueT>(q); // exact, then every step below is exact
+        for (long e = -shift; e > 0; --e)
+            x *= 2;
+        for (long e = -shift; e < 0; ++e)
+            x /= 2;
+        return apply_sign(x);
+    }
+} // namespace detail
+
+/**
+ * @brief Constant evaluation version of simple_parse, for arithmetic types
+ * 
+ * Same rules and results as from_chars_parse; bool takes "0" or "1". Of the
+ * floating types, only float and double are handled.
+ * 
+ * @tparam ValueT arithmetic type, not a character type nor long double
+ * @param str 
+ * @return constant_parsed<ValueT> 
+ */
+template <class ValueT>
+constexpr constant_parsed<ValueT> constant_parse(std::string_view str)
+{
+    static_assert(std::is_same_v<ValueT, bool> || ::detail::from_chars_arithmetic<ValueT>,
+                  "constant_parse handles arithmetic types, characters excepted");
+    if constexpr (std::is_same_v<ValueT, bool>)
+    {
+        const auto& n = ::detail::constant_parse_integral<int>(str);
+        if (!n || (n.value != 0 && n.value != 1))
+            return constant_parsed<bool>::failure(ParsingErrorsT::valuenotparsed);
+        return constant_parsed<bool>::success(n.value == 1);
+    }
+    else if constexpr (std::is_integral_v<ValueT>)
+        return ::detail::constant_parse_integral<ValueT>(str);
     else
+        return ::detail::constant_parse_floating<ValueT>(str);
+}
+
+/**
+ * @brief Constant evaluation version of vector_parse, into exactly N elements
+ * 
+ * @tparam ValueT arithmetic type
+ * @tparam N number of elements
+ * @param str 
+ * @return constant_parsed<std::array<ValueT, N>> emptyvector, or vectorvaluenotparsed
+ * for an element in error or a number of elements other than N
+ */
+template <class ValueT, std::size_t N>
+constexpr constant_parsed<std::array<ValueT, N>> constant_vector_parse(std::string_view str)
+{
+    using result_t = constant_parsed<std::array<ValueT, N>>;
+    std::array<ValueT, N> res{};
+    std::size_t count = 0;
+    for (std::size_t first = 0; first < str.size();)
     {
-       return expected_vector<ValueT>::error(ParsingErrorsT::emptyvector); 
+        const std::size_t last = std::min(str.find(',', first), str.size());
+        if (last != first)
+        {
+            const auto& element = constant_parse<ValueT>(str.substr(first, last - first));
+            if (!element || count == N)
+                return result_t::failure(ParsingErrorsT::vectorvaluenotparsed);
+            res[count++] = element.value;
+        }
+        first = last + 1;
     }
+    if (count == 0)
+        return result_t::failure(ParsingErrorsT::emptyvector);
+    if (count != N)
+        return result_t::failure(ParsingErrorsT::vectorvaluenotparsed);
+    return result_t::success(res);
 }
 
 /**
- * @brief Various error related to file reading, kept in one enum
+ * @brief Constant evaluation version of split_keyvalue_pair
  * 
+ * @param str 
+ * @return constant_parsed<std::pair<std::string_view, std::string_view>> keyvaluenotparsed
  */
-enum FileAndArgsErrorsT
+constexpr constant_parsed<std::pair<std::string_view, std::string_view>> constant_split_keyvalue_pair(std::string_view str)
 {
-    filenotopened,
-    fileioerror,
-    argerror,
-    empty
-};
+    using result_t = constant_parsed<std::pair<std::string_view, std::string_view>>;
+    const std::size_t equal = str.find('=');
+    if (equal == 0 || equal == std::string_view::npos || equal + 1 == str.size()
+        || str.find_first_of("\r\n", equal + 1) != std::string_view::npos)
+        return result_t::failure(ParsingErrorsT::keyvaluenotparsed);
+    return result_t::success({str.substr(0, equal), str.substr(equal + 1)});
+}
 
 /**
  * @brief regex for splitting lines in file
  * 
  */
-const std::regex fileline_re{R"/([^\r\n]+)/"};
+inline const std::regex fileline_re{R"/([^\r\n]+)/"};
 /**
  * @brief regex for splitting command lines arguments 
  * 
  */
-const std::regex commandline_re{R"#(\S+)#"};
+inline const std::regex commandline_re{R"#(\S+)#"};
+
+namespace detail
+{
+    /**
+     * @brief Append the remaining content of a stream to a string, by blocks
+     * 
+     * @param in 
+     * @param out 
+     */
+    inline void read_stream(std::istream& in, std::string& out)
+    {
+        char block[1 << 16];
+        while (in.read(block, sizeof(block)) || in.gcount() > 0)
+            out.append(block, in.gcount());
+    }
+} // namespace detail
 
 /**
  * @brief Get the file object
  * 
  * @param filename 
- * @return const auto 
+ * @return auto 
  */
-const auto get_file(std::string filename)
+inline auto get_file(std::string filename)
 {
+    const ::detail::stage_timer timer(parse_stage::read);
     std::ifstream file_str(filename);
     if (file_str) {
-        file_str >> std::noskipws;
-        const std::string& fstr{std::istream_iterator<char>{file_str}, {}};
+        std::string fstr;
+        ::detail::read_stream(file_str, fstr);
         if (file_str.bad()) 
             return expected<std::string,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::fileioerror);
-        else
-            return expected<std::string,FileAndArgsErrorsT>::success(fstr);
+        ::detail::count_bytes_read(fstr.size());
+        ::detail::count_allocation();
+        return expected<std::string,FileAndArgsErrorsT>::success(std::move(fstr));
     } else
         return expected<std::string,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::filenotopened);
 }
@@ -234,12 +784,14 @@ using expected_args = expected<std::vector<range_value_t<Rng>>,FileAndArgsErrors
  * @tparam Rng 
  * @param str 
  * @param re 
- * @return const auto 
+ * @return auto 
  */
 template<range Rng>
-const auto split_token(Rng&& str, const std::regex& re)
+auto split_token(Rng&& str, const std::regex& re)
 {
-    const auto& res = str
+    const ::detail::stage_timer timer(parse_stage::tokenize);
+    ::detail::count_bytes_scanned(distance(str));
+    auto res = str
                 | views::tokenize(re)
                 | views::remove_if([](auto&& t){ return *(t.first) == '#' || *(t.first) == '%'; })
                 | views::transform([](auto&& t){
@@ -247,7 +799,26 @@ const auto split_token(Rng&& str, const std::regex& re)
                 })
                 | to_vector;
     if (distance(res) > 0)
-        return expected_args<decltype(res)>::success(res);  
+        return expected_args<decltype(res)>::success(std::move(res));
     else
         return expected_args<decltype(res)>::error(FileAndArgsErrorsT::empty);
 }
+
+#ifdef CLINIARG_EXTERN_TEMPLATES
+#include "CliniArg.hpp"
+
+// Instantiated once in the cliniarg library, for std::string and std::string_view values
+#define CLINIARG_EXTERN_RANGES(F, T, ...) \
+    extern template __VA_ARGS__ F<T, std::string>(std::string&&); \
+    extern template __VA_ARGS__ F<T, std::string&>(std::string&); \
+    extern template __VA_ARGS__ F<T, const std::string&>(const std::string&); \
+    extern template __VA_ARGS__ F<T, std::string_view>(std::string_view&&); \
+    extern template __VA_ARGS__ F<T, std::string_view&>(std::string_view&); \
+    extern template __VA_ARGS__ F<T, const std::string_view&>(const std::string_view&);
+#define CLINIARG_EXTERN_PARSE(T) \
+    CLINIARG_EXTERN_RANGES(simple_parse, T, expected<T, ParsingErrorsT>) \
+    CLINIARG_EXTERN_RANGES(vector_parse, T, expected_vector<T>)
+CLINIARG_PARSE_TYPES(CLINIARG_EXTERN_PARSE)
+#undef CLINIARG_EXTERN_PARSE
+#undef CLINIARG_EXTERN_RANGES
+#endif
@@ -0,0 +1,376 @@
+/**
+ * @file ConfigCache.hpp
+ * @brief Binary image of the typed result of a schema load, to skip text parsing on later starts
+ *
+ * After a successful parse, cached_load writes next to the configuration file
+ * (as "<file>.cache") the parsed fields in native binary form, tagged with the
+ * size, modification time and content hash of the source and with a fingerprint
+ * of the schema. The next cached_load maps that image and, when the tags still
+ * match, copies the fields out of it without any text parsing.
+ *
+ * The image is a machine-local cache: native byte order and type sizes, rejected
+ * (and rewritten) as soon as anything does not match.
+ */
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "KeyIndex.hpp"
+#include "MappedFile.hpp"
+#include "ParallelParser.hpp"
+#include "Schema.hpp"
+
+/**
+ * @brief Outcome of a successful cached_load
+ *
+ */
+enum class cache_status
+{
+    hit,         // fields read from the image, no parsing
+    written,     // file parsed and image (re)written
+    not_written  // file parsed, the image could not be written
+};
+
+/**
+ * @brief Error of cached_load
+ *
+ */
+using cached_load_error = load_error;
+
+/**
+ * @brief Identification of a source file content
+ *
+ */
+struct source_tag
+{
+    std::uint64_t size;
+    std::int64_t mtime;
+    std::uint64_t hash;
+
+    bool operator==(const source_tag&) const = default;
+};
+
+namespace detail
+{
+    /**
+     * @brief Fast non cryptographic hash of a buffer, 8 bytes at a time
+     *
+     * @param str
+     * @return std::uint64_t
+     */
+    inline std::uint64_t content_hash(std::string_view str)
+    {
+        std::uint64_t h = 14695981039346656037ull ^ str.size();
+        std::size_t i = 0;
+        for (; i + 8 <= str.size(); i += 8)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, str.data() + i, 8);
+            h = std::rotl((h ^ w) * 0x9e3779b97f4a7c15ull, 29);
+        }
+        for (; i < str.size(); ++i)
+            h = (h ^ static_cast<unsigned char>(str[i])) * 1099511628211ull;
+        return hash_mix(h);
+    }
+
+    /**
+     * @brief Types stored in an image: arithmetic and enum values, arrays, strings and vectors of them
+     *
+     * Only types without pointers: an address written in an image would dangle once read back.
+     */
+    template <class T>
+    struct is_cacheable : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+    template <class ValueT, std::size_t N>
+    struct is_cacheable<std::array<ValueT, N>> : std::bool_constant<std::is_arithmetic_v<ValueT> || std::is_enum_v<ValueT>> {};
+
+    template <>
+    struct is_cacheable<std::string> : std::true_type {};
+
+    template <class ValueT, class AllocT>
+    struct is_cacheable<std::vector<ValueT, AllocT>> : is_cacheable<ValueT> {};
+
+    /**
+     * @brief Code of a member type in the schema fingerprint
+     *
+     */
+    template <class T>
+    constexpr std::uint64_t cache_type_code()
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return 's';
+        else if constexpr (is_vector<T>::value)
+            return hash_mix('v' ^ cache_type_code<typename T::value_type>());
+        else if constexpr (is_cacheable<T>::value && !std::is_arithmetic_v<T> && !std::is_enum_v<T>) // std::array
+            return hash_mix('a' ^ (std::tuple_size_v<T> << 8) ^ cache_type_code<typename T::value_type>());
+        else
+            return (sizeof(T) << 8) | (std::is_floating_point_v<T> << 1) | std::is_signed_v<T>;
+    }
+
+    template <class>
+    struct cache_codec;
+
+    /**
+     * @brief Binary encoding of the fields of a schema
+     *
+     */
+    template <class... Fields>
+    struct cache_codec<schema<Fields...>>
+    {
+        using schema_type = schema<Fields...>;
+        using properties_type = typename schema_type::properties_type;
+
+        static_assert((is_cacheable<typename Fields::member_type>::value && ...),
+                      "cached_load only stores arithmetic, enum, std::array, std::string and std::vector members");
+
+        /**
+         * @brief Hash of the field names and member types
+         *
+         */
+        static constexpr std::uint64_t fingerprint()
+        {
+            std::uint64_t h = 0;
+            ((h = hash_mix(h ^ normalized_hash(Fields::name)) ^ cache_type_code<typename Fields::member_type>()), ...);
+            return hash_mix(h);
+        }
+
+        static void encode(std::string& out, const properties_type& props, const std::array<bool, sizeof...(Fields)>& assigned)
+        {
+            encode(out, props, assigned, std::index_sequence_for<Fields...>{});
+        }
+
+        /**
+         * @brief Decode the image fields into props, not modified if the image is truncated
+         *
+         * @return true the whole image has been decoded
+         */
+        static bool decode(std::string_view in, properties_type& props)
+        {
+            properties_type decoded{};
+            std::array<bool, sizeof...(Fields)> assigned{};
+            if (!decode(in, decoded, assigned, std::index_sequence_for<Fields...>{}) || !in.empty())
+                return false;
+            schema_type::merge(props, decoded, assigned);
+            return true;
+        }
+
+    private:
+        template <std::size_t... I>
+        static void encode(std::string& out, const properties_type& props, const std::array<bool, sizeof...(Fields)>& assigned, std::index_sequence<I...>)
+        {
+            ((write(out, assigned[I]), assigned[I] ? write(out, props.*Fields::member) : void()), ...);
+        }
+
+        template <std::size_t... I>
+        static bool decode(std::string_view& in, properties_type& props, std::array<bool, sizeof...(Fields)>& assigned, std::index_sequence<I...>)
+        {
+            return ((read(in, assigned[I]) && (!assigned[I] || read(in, props.*Fields::member))) && ...);
+        }
+
+        template <class T>
+        static void write(std::string& out, const T& value)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                write(out, std::uint64_t{value.size()});
+                out.append(value);
+            }
+            else if constexpr (is_vector<T>::value)
+            {
+                using value_type = typename T::value_type;
+                write(out, std::uint64_t{value.size()});
+                if constexpr (std::is_trivially_copyable_v<value_type> && !std::is_same_v<value_type, bool>)
+                    out.append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(value_type));
+                else
+                    for (const value_type& element : value)
+                        write(out, element);
+            }
+            else
+                out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <class T>
+        static bool read(std::string_view& in, T& value)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                std::uint64_t size;
+                if (!read(in, size) || size > in.size())
+                    return false;
+                value.assign(in.data(), size);
+                in.remove_prefix(size);
+            }
+            else if constexpr (is_vector<T>::value)
+            {
+                using value_type = typename T::value_type;
+                std::uint64_t size;
+                if (!read(in, size))
+                    return false;
+                if constexpr (std::is_trivially_copyable_v<value_type> && !std::is_same_v<value_type, bool>)
+                {
+                    if (size > in.size() / sizeof(value_type))
+                        return false;
+                    value.resize(size);
+                    std::memcpy(value.data(), in.data(), size * sizeof(value_type));
+                    in.remove_prefix(size * sizeof(value_type));
+                }
+                else
+                {
+                    value.clear();
+                    for (std::uint64_t i = 0; i < size; ++i)
+                    {
+                        value_type element;
+                        if (!read(in, element))
+                            return false;
+                        value.push_back(std::move(element));
+                    }
+                }
+            }
+            else
+            {
+                if (in.size() < sizeof(T))
+                    return false;
+                std::memcpy(&value, in.data(), sizeof(T));
+                in.remove_prefix(sizeof(T));
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Header of an image
+     *
+     */
+    struct cache_header
+    {
+        static constexpr std::uint32_t expected_magic = 0x434c4e43; // also rejects the other byte order
+        static constexpr std::uint32_t expected_version = 1;
+
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t fingerprint;
+        source_tag source;
+    };
+
+    /**
+     * @brief Modification time of a file, 0 if unknown
+     *
+     */
+    inline std::int64_t modification_time(const std::string& filename)
+    {
+        std::error_code ec;
+        const auto time = std::filesystem::last_write_time(filename, ec);
+        return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    /**
+     * @brief Write the image through a temporary file renamed over cache_filename,
+     * so that concurrent processes never map a partial image
+     *
+     * @return true the image has been written
+     */
+    inline bool write_image(const std::string& cache_filename, const std::string& image)
+    {
+        const std::string tmp_filename = cache_filename + ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+            if (!out.write(image.data(), image.size()) || !out.flush())
+            {
+                std::error_code ec;
+                std::filesystem::remove(tmp_filename, ec);
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp_filename, cache_filename, ec);
+        if (ec)
+            std::filesystem::remove(tmp_filename, ec);
+        return !ec;
+    }
+} // namespace detail
+
+/**
+ * @brief Load filename into props through a binary image in cache_filename
+ *
+ * If the image matches the schema and the current content of filename, its
+ * fields are copied into props without parsing. Otherwise filename is parsed,
+ * same result as Schema::load(props, split_lines(content).get()), and on
+ * success the image is rewritten. Only the keys present in the file are
+ * stored: the other members of props keep their value in both cases.
+ *
+ * @tparam Schema schema<...> of the properties, with trivially copyable, std::string or std::vector members
+ * @param props
+ * @param filename
+ * @param cache_filename
+ * @return expected<cache_status, cached_load_error>
+ */
+template <class Schema>
+expected<cache_status, cached_load_error> cached_load(typename Schema::properties_type& props,
+                                                      const std::string& filename, const std::string& cache_filename)
+{
+    using codec = ::detail::cache_codec<Schema>;
+    using result_t = expected<cache_status, cached_load_error>;
+
+    const std::int64_t mtime = ::detail::modification_time(filename);
+    const auto& file = map_file(filename);
+    if (!file)
+        return result_t::error(file.error());
+    const std::string_view content = file.get().view();
+
+    ::detail::cache_header header{};
+    header.magic = ::detail::cache_header::expected_magic;
+    header.version = ::detail::cache_header::expected_version;
+    header.fingerprint = codec::fingerprint();
+    header.source = source_tag{content.size(), mtime, 0};
+
+    // the content is only hashed (read) once the cheap tags match: a rewrite
+    // of the same size with its modification time restored is still caught
+    bool hashed = false;
+    if (const auto& image = map_file(cache_filename); image && image.get().size() >= sizeof(header))
+    {
+        ::detail::cache_header image_header;
+        std::memcpy(&image_header, image.get().data(), sizeof(image_header));
+        if (image_header.magic == header.magic && image_header.version == header.version
+            && image_header.fingerprint == header.fingerprint
+            && image_header.source.size == header.source.size && image_header.source.mtime == header.source.mtime)
+        {
+            header.source.hash = ::detail::content_hash(content);
+            hashed = true;
+            if (image_header.source.hash == header.source.hash
+                && codec::decode(image.get().view().substr(sizeof(header)), props))
+                return result_t::success(cache_status::hit);
+        }
+    }
+
+    auto chunk = ::detail::parse_chunk<Schema>(content, 0, content.size());
+    Schema::merge(props, chunk.props, chunk.assigned);
+    if (chunk.error)
+        return result_t::error(*chunk.error);
+
+    if (!hashed)
+        header.source.hash = ::detail::content_hash(content);
+    std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+    codec::encode(image, props, chunk.assigned);
+    return result_t::success(::detail::write_image(cache_filename, image) ? cache_status::written : cache_status::not_written);
+}
+
+/**
+ * @brief cached_load with the image next to the file, as "<filename>.cache"
+ *
+ */
+template <class Schema>
+expected<cache_status, cached_load_error> cached_load(typename Schema::properties_type& props, const std::string& filename)
+{
+    return cached_load<Schema>(props, filename, filename + ".cache");
+}
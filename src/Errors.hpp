@@ -0,0 +1,42 @@
+/**
+ * @file Errors.hpp
+ * @brief Error enums shared by every parser, without any other dependency
+ *
+ */
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Various error related to parsing, kept in one enum
+ * 
+ */
+enum ParsingErrorsT
+{
+    keyvaluenotparsed,
+    keynotfound,
+    valuenotparsed,
+    emptyvector,
+    vectorvaluenotparsed,
+    sectionnotparsed,
+    rangenotparsed,
+    rangezerostep,
+    rangewrongdirection
+};
+
+/**
+ * @brief Number of ParsingErrorsT values
+ * 
+ */
+inline constexpr std::size_t parsing_error_count = ParsingErrorsT::rangewrongdirection + 1;
+
+/**
+ * @brief Various error related to file reading, kept in one enum
+ * 
+ */
+enum FileAndArgsErrorsT
+{
+    filenotopened,
+    fileioerror,
+    argerror,
+    empty
+};
@@ -0,0 +1,70 @@
+/**
+ * @file EventParser.hpp
+ * @brief Pull parser: the lines of an INI text as a stream of events
+ *
+ * parse_events produces the events of a text one at a time, when the loop
+ * asks for the next one: nothing is materialized, and breaking out of the
+ * loop stops the parsing, so that looking for a few keys only costs the
+ * prefix of the text that precedes them. The lines are found with the
+ * vectorized scanner, a block of about 64 KiB at a time.
+ *
+ *     for (const parse_event& e : parse_events(text))
+ *         if (e.type == event_type::keyvalue && e.key == "seed")
+ *             return simple_parse<int>(e.value);
+ */
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Generator.hpp"
+#include "IniIndex.hpp"
+#include "Scanner.hpp"
+
+/**
+ * @brief Events of the lines of text, in order, blank lines skipped
+ *
+ * The views of the events point into text, which must outlive the generator.
+ * A huge file is best given through map_file: only the pages of the prefix
+ * that is parsed are read.
+ *
+ * @param text
+ * @param block_size bytes scanned at a time, extended to the end of the line
+ * @return generator<parse_event>
+ */
+inline generator<parse_event> parse_events(std::string_view text, std::size_t block_size = std::size_t{1} << 16)
+{
+    struct line_token
+    {
+        std::size_t first, last;
+        bool comment;
+    };
+    std::vector<line_token> lines; // lines of the current block, reused
+    block_size = std::max<std::size_t>(block_size, 1);
+
+    for (std::size_t first = 0; first < text.size();)
+    {
+        // cut the block after a line break, so that no line spans two blocks
+        std::size_t last = std::min(first + block_size, text.size());
+        if (last < text.size())
+        {
+            const std::size_t brk = text.find_first_of("\r\n", last - 1);
+            last = brk == std::string_view::npos ? text.size() : brk + 1;
+        }
+
+        lines.clear();
+        for_each_token<scan_class::line>(text.substr(first, last - first), [&](std::size_t line_first, std::size_t line_last, bool comment) {
+            lines.push_back({first + line_first, first + line_last, comment});
+        });
+        for (const line_token& t : lines)
+        {
+            const std::string_view line = text.substr(t.first, t.last - t.first);
+            if (t.comment)
+                co_yield parse_event{event_type::comment, t.first, {}, line};
+            else
+                co_yield ::detail::line_event(line, t.first);
+        }
+        first = last;
+    }
+}
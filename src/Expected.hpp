@@ -1,5 +1,8 @@
 #pragma once
 // https://gitlab.com/manning-fpcpp-book/code-examples/-/blob/master/chapter-12/bookmark-service-with-reply/expected.h
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 // Based on expected<T> by Alexandrescu,
 // with some nice syntax sugar on top
@@ -45,7 +48,7 @@ class expected
         }
     }
 
-    expected(expected &&other)
+    expected(expected &&other) noexcept(std::is_nothrow_move_constructible_v<T> &&std::is_nothrow_move_constructible_v<E>)
         : m_isValid(other.m_isValid)
     {
         if (m_isValid)
@@ -138,20 +141,27 @@ class expected
 #define THROW_IF_EXCEPTIONS_ARE_ENABLED(WHAT) throw std::logic_error(WHAT)
 #endif
 
-    T &get()
+    T &get() &
     {
         if (!m_isValid)
             THROW_IF_EXCEPTIONS_ARE_ENABLED("expected<T, E> contains no value");
         return m_value;
     }
 
-    const T &get() const
+    const T &get() const &
     {
         if (!m_isValid)
             THROW_IF_EXCEPTIONS_ARE_ENABLED("expected<T, E> contains no value");
         return m_value;
     }
 
+    T &&get() &&
+    {
+        if (!m_isValid)
+            THROW_IF_EXCEPTIONS_ARE_ENABLED("expected<T, E> contains no value");
+        return std::move(m_value);
+    }
+
     T *operator->()
     {
         return &get();
@@ -190,6 +200,82 @@ class expected
             f(m_error);
         }
     }
+
+    // Monadic operations, as std::expected: on an rvalue the value
+    // (or the error) is moved to f or to the result instead of copied
+
+    template <typename U>
+    T value_or(U &&default_value) const &
+    {
+        return m_isValid ? m_value : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    T value_or(U &&default_value) &&
+    {
+        return m_isValid ? std::move(m_value) : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    // f(value) -> expected<U, E>
+    template <typename F>
+    auto and_then(F &&f) & { return and_then_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto and_then(F &&f) const & { return and_then_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto and_then(F &&f) && { return and_then_impl(std::move(*this), std::forward<F>(f)); }
+
+    // f(value) -> U, wrapped in expected<U, E>
+    template <typename F>
+    auto transform(F &&f) & { return transform_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform(F &&f) const & { return transform_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto transform(F &&f) && { return transform_impl(std::move(*this), std::forward<F>(f)); }
+
+    // f(error) -> expected<T, G>
+    template <typename F>
+    auto or_else(F &&f) & { return or_else_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto or_else(F &&f) const & { return or_else_impl(*this, std::forward<F>(f)); }
+    template <typename F>
+    auto or_else(F &&f) && { return or_else_impl(std::move(*this), std::forward<F>(f)); }
+
+  private:
+    template <typename Self, typename F>
+    static auto and_then_impl(Self &&self, F &&f)
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).m_value))>>;
+        if (self.m_isValid)
+            return result_type(std::invoke(std::forward<F>(f), std::forward<Self>(self).m_value));
+        else
+            return result_type::error(std::forward<Self>(self).m_error);
+    }
+
+    template <typename Self, typename F>
+    static auto transform_impl(Self &&self, F &&f)
+    {
+        using value_type = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).m_value))>>;
+        using result_type = expected<value_type, E>;
+        if (!self.m_isValid)
+            return result_type::error(std::forward<Self>(self).m_error);
+        if constexpr (std::is_void_v<value_type>)
+        {
+            std::invoke(std::forward<F>(f), std::forward<Self>(self).m_value);
+            return result_type::success();
+        }
+        else
+            return result_type::success(std::invoke(std::forward<F>(f), std::forward<Self>(self).m_value));
+    }
+
+    template <typename Self, typename F>
+    static auto or_else_impl(Self &&self, F &&f)
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).m_error))>>;
+        if (self.m_isValid)
+            return result_type::success(std::forward<Self>(self).m_value);
+        else
+            return result_type(std::invoke(std::forward<F>(f), std::forward<Self>(self).m_error));
+    }
 };
 
 template <typename E>
@@ -231,7 +317,7 @@ class expected<void, E>
         }
     }
 
-    expected(expected &&other)
+    expected(expected &&other) noexcept(std::is_nothrow_move_constructible_v<E>)
         : m_isValid(other.m_isValid)
     {
         if (m_isValid)
@@ -334,6 +420,82 @@ class expected<void, E>
             THROW_IF_EXCEPTIONS_ARE_ENABLED("There is no error in this expected<T, E>");
         return m_error;
     }
+
+#undef THROW_IF_EXCEPTIONS_ARE_ENABLED
+
+    // Monadic operations, f taking no value
+
+    // f() -> expected<U, E>
+    template <typename F>
+    auto and_then(F &&f) const &
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F>>;
+        if (m_isValid)
+            return result_type(std::invoke(std::forward<F>(f)));
+        else
+            return result_type::error(m_error);
+    }
+
+    template <typename F>
+    auto and_then(F &&f) &&
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F>>;
+        if (m_isValid)
+            return result_type(std::invoke(std::forward<F>(f)));
+        else
+            return result_type::error(std::move(m_error));
+    }
+
+    // f() -> U, wrapped in expected<U, E>
+    template <typename F>
+    auto transform(F &&f) const &
+    {
+        return expected(*this).transform_impl(std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto transform(F &&f) &&
+    {
+        return std::move(*this).transform_impl(std::forward<F>(f));
+    }
+
+    // f(error) -> expected<void, G>
+    template <typename F>
+    auto or_else(F &&f) const &
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F, const E &>>;
+        if (m_isValid)
+            return result_type::success();
+        else
+            return result_type(std::invoke(std::forward<F>(f), m_error));
+    }
+
+    template <typename F>
+    auto or_else(F &&f) &&
+    {
+        using result_type = std::remove_cvref_t<std::invoke_result_t<F, E &&>>;
+        if (m_isValid)
+            return result_type::success();
+        else
+            return result_type(std::invoke(std::forward<F>(f), std::move(m_error)));
+    }
+
+  private:
+    template <typename F>
+    auto transform_impl(F &&f) &&
+    {
+        using value_type = std::remove_cvref_t<std::invoke_result_t<F>>;
+        using result_type = expected<value_type, E>;
+        if (!m_isValid)
+            return result_type::error(std::move(m_error));
+        if constexpr (std::is_void_v<value_type>)
+        {
+            std::invoke(std::forward<F>(f));
+            return result_type::success();
+        }
+        else
+            return result_type::success(std::invoke(std::forward<F>(f)));
+    }
 };
 
 template <typename T, typename E, typename Function, typename ResultType = decltype(std::declval<Function>()(std::declval<T>()))>
@@ -348,3 +510,9 @@ ResultType mbind(const expected<T, E> &exp, Function f)
         return ResultType::error(exp.error());
     }
 }
+
+template <typename T, typename E, typename Function, typename ResultType = decltype(std::declval<Function>()(std::declval<T>()))>
+ResultType mbind(expected<T, E> &&exp, Function f)
+{
+    return std::move(exp).and_then(f);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file Generator.hpp
+ * @brief Minimal C++20 coroutine generator, an input range of the yielded values
+ *
+ * The values are produced one at a time, when the consumer advances: breaking
+ * out of the loop stops the coroutine where it is. The reference returned by
+ * the iterator is valid until the next increment.
+ */
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Coroutine returning co_yield'ed values of type T
+ *
+ * @tparam T
+ */
+template <class T>
+class generator : public std::ranges::view_interface<generator<T>>
+{
+public:
+    struct promise_type
+    {
+        const T* m_current = nullptr;
+        std::exception_ptr m_exception;
+
+        generator get_return_object() { return generator(handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+
+        // the yielded value lives in the coroutine frame until it resumes
+        std::suspend_always yield_value(const T& value) noexcept
+        {
+            m_current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() { m_exception = std::current_exception(); }
+
+        template <class U>
+        std::suspend_never await_transform(U&&) = delete; // no co_await in a generator
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(handle coroutine) : m_coroutine(coroutine) {}
+
+        const T& operator*() const { return *m_coroutine.promise().m_current; }
+        const T* operator->() const { return m_coroutine.promise().m_current; }
+
+        iterator& operator++()
+        {
+            resume(m_coroutine);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) { return !it.m_coroutine || it.m_coroutine.done(); }
+
+    private:
+        handle m_coroutine = nullptr;
+    };
+
+    generator() = default;
+    generator(generator&& other) noexcept : m_coroutine(std::exchange(other.m_coroutine, nullptr)) {}
+
+    generator& operator=(generator&& other) noexcept
+    {
+        std::swap(m_coroutine, other.m_coroutine);
+        return *this;
+    }
+
+    ~generator()
+    {
+        if (m_coroutine)
+            m_coroutine.destroy();
+    }
+
+    /**
+     * @brief Run the coroutine up to its first value: begin() is called once
+     *
+     */
+    iterator begin()
+    {
+        if (m_coroutine)
+            resume(m_coroutine);
+        return iterator(m_coroutine);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit generator(handle coroutine) : m_coroutine(coroutine) {}
+
+    /**
+     * @brief Resume the coroutine, rethrowing what escaped from its body
+     *
+     */
+    static void resume(handle coroutine)
+    {
+        coroutine.resume();
+        if (coroutine.done() && coroutine.promise().m_exception)
+            std::rethrow_exception(coroutine.promise().m_exception);
+    }
+
+    handle m_coroutine = nullptr;
+};
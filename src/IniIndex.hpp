@@ -0,0 +1,322 @@
+/**
+ * @file IniIndex.hpp
+ * @brief Section-aware INI parsing into one flat, sorted index
+ *
+ * "[section]" lines open a section, the key/value lines before the first
+ * header belong to the "" section. Every entry goes into a single contiguous
+ * array sorted by the hash of its normalized (section, key): a lookup is a
+ * binary search over an array of hashes, without any node or pointer chasing.
+ * Sections, keys and values are kept as offsets into the source buffer and
+ * values are only parsed when asked for.
+ */
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "KeyIndex.hpp"
+#include "Scanner.hpp"
+#include "Schema.hpp"
+
+/**
+ * @brief Kind of parse_event
+ *
+ */
+enum class event_type
+{
+    keyvalue, // key=value line
+    section,  // "[name]" line
+    comment,  // line starting with '#' or '%'
+    error     // line that is none of the above, parsing goes on after it
+};
+
+/**
+ * @brief One line of the text, with views into it
+ *
+ */
+struct parse_event
+{
+    event_type type;
+    std::size_t offset;     // of the line in the text
+    std::string_view key;   // keyvalue: raw key, section: name between the brackets
+    std::string_view value; // keyvalue: raw value, comment and error: the whole line
+    ParsingErrorsT error = ParsingErrorsT::keyvaluenotparsed; // error: keyvaluenotparsed or sectionnotparsed
+};
+
+namespace detail
+{
+    /**
+     * @brief Hash of a (section, key) pair, both normalized as trim_spaces_underscores_andlower
+     *
+     */
+    constexpr std::uint64_t section_key_hash(std::string_view section, std::string_view key)
+    {
+        return hash_mix(normalized_hash(section)) ^ normalized_hash(key);
+    }
+
+    /**
+     * @brief Remove the leading and trailing spaces
+     *
+     */
+    inline std::string_view trim_blanks(std::string_view str)
+    {
+        const auto first = str.find_first_not_of(" \t\v\f");
+        if (first == std::string_view::npos)
+            return {};
+        return str.substr(first, str.find_last_not_of(" \t\v\f") - first + 1);
+    }
+
+    /**
+     * @brief Event of one non comment line: the classification of lines shared
+     * by for_each_entry and parse_events
+     *
+     */
+    inline parse_event line_event(std::string_view line, std::size_t offset)
+    {
+        const std::string_view header = trim_blanks(line);
+        if (!header.empty() && header.front() == '[')
+        {
+            if (header.size() < 2 || header.back() != ']')
+                return {event_type::error, offset, {}, line, ParsingErrorsT::sectionnotparsed};
+            return {event_type::section, offset, header.substr(1, header.size() - 2), {}};
+        }
+        const auto& kv = split_keyvalue_pair(line);
+        if (!kv)
+            return {event_type::error, offset, {}, line, kv.error().second};
+        return {event_type::keyvalue, offset, to_string_view(kv.get().first), to_string_view(kv.get().second)};
+    }
+
+    /**
+     * @brief Part of a source buffer, as offsets so that it survives moves of the buffer
+     *
+     */
+    struct text_span
+    {
+        std::size_t offset;
+        std::size_t size;
+
+        static text_span of(std::string_view source, std::string_view str)
+        {
+            return {static_cast<std::size_t>(str.data() - source.data()), str.size()};
+        }
+
+        std::string_view in(std::string_view source) const { return source.substr(offset, size); }
+    };
+
+    /**
+     * @brief Split source in section headers and key/value entries, comments skipped
+     *
+     * Sections are numbered in input order from 1, the entries before the first
+     * header belong to section 0.
+     *
+     * @tparam Class delimiters between entries
+     * @param source
+     * @param on_section called with the name of every section, between the brackets
+     * @param on_keyvalue called with the section number, the raw key and the raw value of every entry
+     * @return std::optional<std::pair<std::size_t, ParsingErrorsT>> the first malformed entry,
+     * positioned at the entry (keyvaluenotparsed, sectionnotparsed)
+     */
+    template <scan_class Class, class SectionF, class KeyValueF>
+    std::optional<std::pair<std::size_t, ParsingErrorsT>> for_each_entry(std::string_view source, SectionF&& on_section, KeyValueF&& on_keyvalue)
+    {
+        std::optional<std::pair<std::size_t, ParsingErrorsT>> error;
+        std::uint32_t section = 0;
+        for_each_token<Class>(source, [&](std::size_t first, std::size_t last, bool comment) {
+            if (comment || error)
+                return;
+            const parse_event e = line_event(source.substr(first, last - first), first);
+            if (e.type == event_type::section)
+            {
+                ++section;
+                on_section(e.key);
+            }
+            else if (e.type == event_type::keyvalue)
+                on_keyvalue(section, e.key, e.value);
+            else
+                error.emplace(first, e.error);
+        });
+        return error;
+    }
+} // namespace detail
+
+/**
+ * @brief Flat index of the entries of an INI buffer, which must outlive it
+ *
+ */
+class ini_index
+{
+public:
+    /**
+     * @brief Error payload: input offset and error
+     *
+     */
+    using error_type = std::pair<std::size_t, ParsingErrorsT>;
+
+    /**
+     * @brief Split source in sections and key/value entries, without parsing the values
+     *
+     * @tparam Class delimiters between entries: lines, or spaces for a command line
+     * @param source
+     * @return expected<ini_index, error_type> stopping at the first malformed entry,
+     * positioned at the entry (keyvaluenotparsed, sectionnotparsed)
+     */
+    template <scan_class Class = scan_class::line>
+    static expected<ini_index, error_type> build(std::string_view source)
+    {
+        ini_index index(source);
+        const auto& error = ::detail::for_each_entry<Class>(source,
+            [&](std::string_view section) { index.m_sections.push_back(index.span(section)); },
+            [&](std::uint32_t section, std::string_view key, std::string_view value) {
+                index.m_entries.push_back(entry{index.span(key), index.span(value), section});
+            });
+        if (error)
+            return expected<ini_index, error_type>::error(*error);
+        index.sort();
+        return expected<ini_index, error_type>::success(std::move(index));
+    }
+
+    /**
+     * @brief Raw value of the last occurrence of key in section
+     *
+     * @param section section name, normalized on the fly
+     * @param key key name, normalized on the fly
+     * @return std::optional<std::string_view>
+     */
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) const
+    {
+        const entry* e = find_entry(section, key);
+        if (!e)
+            return std::nullopt;
+        return text(e->value);
+    }
+
+    /**
+     * @brief Parse the value of the last occurrence of key in section, as parse_as<ValueT>
+     *
+     * @tparam ValueT
+     * @param section
+     * @param key
+     * @return expected<ValueT, ParsingErrorsT> keynotfound if there is no such key
+     */
+    template <class ValueT>
+    expected<ValueT, ParsingErrorsT> get(std::string_view section, std::string_view key) const
+    {
+        const auto& value = find(section, key);
+        if (!value)
+        {
+            ::detail::count_error(ParsingErrorsT::keynotfound);
+            return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::keynotfound);
+        }
+        return parse_as<ValueT>(*value);
+    }
+
+    /**
+     * @brief Assign the fields of a schema from the keys of one section
+     *
+     * The keys of the section that are not in the schema are ignored, the
+     * fields absent from the section keep their value.
+     *
+     * @tparam Schema schema<...> of the properties
+     * @param props
+     * @param section
+     * @return expected<void, error_type> stopping at the first value in error, positioned at the value
+     */
+    template <class Schema>
+    expected<void, error_type> load(typename Schema::properties_type& props, std::string_view section) const
+    {
+        for (std::size_t index = 0; index < Schema::size; ++index)
+            if (const entry* e = find_entry(section, Schema::keys.name(index)))
+            {
+                const auto& res = Schema::assign_field(props, index, text(e->value));
+                if (!res)
+                    return expected<void, error_type>::error(e->value.offset, res.error());
+            }
+        return expected<void, error_type>::success();
+    }
+
+    /**
+     * @brief Section names, in input order, "" first, repeated if a header is repeated
+     *
+     * @return std::vector<std::string_view>
+     */
+    std::vector<std::string_view> sections() const
+    {
+        std::vector<std::string_view> res;
+        res.reserve(m_sections.size());
+        for (const auto& s : m_sections)
+            res.push_back(text(s));
+        return res;
+    }
+
+    /**
+     * @brief Number of key/value entries, duplicates included
+     *
+     */
+    std::size_t size() const noexcept { return m_entries.size(); }
+
+    /**
+     * @brief Indexed buffer
+     *
+     */
+    std::string_view source() const noexcept { return m_source; }
+
+private:
+    using span_t = ::detail::text_span;
+
+    struct entry
+    {
+        span_t key;
+        span_t value;
+        std::uint32_t section;
+    };
+
+    explicit ini_index(std::string_view source) : m_source(source), m_sections{span_t{0, 0}} {}
+
+    span_t span(std::string_view str) const { return span_t::of(m_source, str); }
+    std::string_view text(span_t s) const { return s.in(m_source); }
+
+    /**
+     * @brief Sort the entries by hash, keeping the input order of equal hashes,
+     * and store the hashes apart for the binary search
+     *
+     */
+    void sort()
+    {
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> order(m_entries.size());
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+            order[i] = {::detail::section_key_hash(text(m_sections[m_entries[i].section]), text(m_entries[i].key)),
+                        static_cast<std::uint32_t>(i)};
+        std::sort(order.begin(), order.end()); // the index breaks the ties in input order
+
+        std::vector<entry> sorted;
+        sorted.reserve(m_entries.size());
+        m_hashes.reserve(m_entries.size());
+        for (const auto& [hash, i] : order)
+        {
+            m_hashes.push_back(hash);
+            sorted.push_back(m_entries[i]);
+        }
+        m_entries = std::move(sorted);
+    }
+
+    const entry* find_entry(std::string_view section, std::string_view key) const
+    {
+        const std::uint64_t hash = ::detail::section_key_hash(section, key);
+        const auto [first, last] = std::equal_range(m_hashes.begin(), m_hashes.end(), hash);
+        for (auto it = last; it != first;) // last occurrence first
+        {
+            const entry& e = m_entries[--it - m_hashes.begin()];
+            if (::detail::normalized_equal(text(e.key), key) && ::detail::normalized_equal(text(m_sections[e.section]), section))
+                return &e;
+        }
+        return nullptr;
+    }
+
+    std::string_view m_source;
+    std::vector<span_t> m_sections;
+    std::vector<std::uint64_t> m_hashes; // sorted, one per entry
+    std::vector<entry> m_entries;
+};
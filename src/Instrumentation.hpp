@@ -0,0 +1,351 @@
+/**
+ * @file Instrumentation.hpp
+ * @brief Optional per stage timers and counters of the parsers
+ *
+ * Defining CLINIARG_INSTRUMENTATION (for the whole program) makes the parsers
+ * time their stages (file reading, tokenizing, key/value splitting, value
+ * parsing) and count bytes, lines, keys, errors per ParsingErrorsT value and
+ * the allocations of their results. Without it every hook is an empty inline
+ * function and stats() returns zeros.
+ *
+ * Stage times are exclusive: the time spent in a nested stage (a value parsed
+ * from a tokenizer callback, for instance) is only counted for that stage.
+ */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Errors.hpp"
+
+#ifdef CLINIARG_INSTRUMENTATION
+#include <atomic>
+#include <chrono>
+#endif
+
+/**
+ * @brief Instrumented stage of a load
+ *
+ */
+enum class parse_stage
+{
+    read,           // get_file, map_file
+    tokenize,       // split_token, for_each_token and the splitters built on it
+    split_keyvalue, // split_keyvalue_pair
+    parse_value     // simple_parse, vector_parse, numeric_vector_parse, lazy_vector_parse
+};
+
+inline constexpr std::size_t parse_stage_count = 4;
+
+inline constexpr bool instrumentation_enabled =
+#ifdef CLINIARG_INSTRUMENTATION
+    true;
+#else
+    false;
+#endif
+
+/**
+ * @brief Counters accumulated by every thread since the start or the last reset_stats()
+ *
+ */
+struct parse_stats
+{
+    std::array<std::uint64_t, parse_stage_count> nanoseconds{}; // exclusive time per stage
+    std::array<std::uint64_t, parse_stage_count> calls{};
+    std::uint64_t bytes_read = 0;    // file content
+    std::uint64_t bytes_scanned = 0; // input of the tokenizers
+    std::uint64_t lines = 0;         // lines found by for_each_token<scan_class::line>, comments included
+    std::uint64_t keys = 0;          // key/value pairs split
+    std::uint64_t allocations = 0;   // file contents and vector values allocated
+    std::array<std::uint64_t, parsing_error_count> errors{}; // per ParsingErrorsT value
+};
+
+/**
+ * @brief Called at the end of every outermost stage with its duration, inclusive
+ *
+ */
+using stage_callback = void (*)(parse_stage stage, std::uint64_t nanoseconds);
+
+namespace detail
+{
+#ifdef CLINIARG_INSTRUMENTATION
+    struct atomic_stats
+    {
+        std::array<std::atomic<std::uint64_t>, parse_stage_count> nanoseconds{};
+        std::array<std::atomic<std::uint64_t>, parse_stage_count> calls{};
+        std::atomic<std::uint64_t> bytes_read{0};
+        std::atomic<std::uint64_t> bytes_scanned{0};
+        std::atomic<std::uint64_t> lines{0};
+        std::atomic<std::uint64_t> keys{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::array<std::atomic<std::uint64_t>, parsing_error_count> errors{};
+        std::atomic<stage_callback> callback{nullptr};
+    };
+
+    inline atomic_stats& global_stats()
+    {
+        static atomic_stats stats;
+        return stats;
+    }
+
+    inline void add(std::atomic<std::uint64_t>& counter, std::uint64_t n)
+    {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Stages running on this thread, innermost last
+     *
+     */
+    struct stage_frame
+    {
+        parse_stage stage;
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t nested; // time spent in the nested stages
+    };
+
+    struct stage_stack
+    {
+        static constexpr std::size_t capacity = 32;
+        std::array<stage_frame, capacity> frames;
+        std::size_t size = 0;
+    };
+
+    inline thread_local stage_stack stages;
+
+    /**
+     * @brief Times a stage for as long as it lives
+     *
+     */
+    class stage_scope
+    {
+    public:
+        explicit stage_scope(parse_stage stage)
+        {
+            if (stages.size < stage_stack::capacity)
+            {
+                // same stage as the enclosing one (vector_parse calling simple_parse): counted once
+                m_outer_same = stages.size > 0 && stages.frames[stages.size - 1].stage == stage;
+                stages.frames[stages.size++] = stage_frame{stage, std::chrono::steady_clock::now(), 0};
+                m_active = true;
+            }
+        }
+
+        stage_scope(const stage_scope&) = delete;
+        stage_scope& operator=(const stage_scope&) = delete;
+
+        ~stage_scope()
+        {
+            if (!m_active)
+                return;
+            const stage_frame frame = stages.frames[--stages.size];
+            const auto elapsed = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frame.start).count());
+            const auto index = static_cast<std::size_t>(frame.stage);
+            add(global_stats().nanoseconds[index], elapsed - std::min(elapsed, frame.nested));
+            if (!m_outer_same)
+                add(global_stats().calls[index], 1);
+            if (stages.size > 0)
+                stages.frames[stages.size - 1].nested += elapsed;
+            else if (const stage_callback callback = global_stats().callback.load(std::memory_order_relaxed))
+                callback(frame.stage, elapsed);
+        }
+
+        /**
+         * @brief Whether the errors of this scope are counted: not when the enclosing scope is the same stage
+         *
+         */
+        bool counts_errors() const noexcept { return m_active && !m_outer_same; }
+
+    private:
+        bool m_active = false;
+        bool m_outer_same = false;
+    };
+
+    inline void count_error(ParsingErrorsT error)
+    {
+        if (static_cast<std::size_t>(error) < parsing_error_count)
+            add(global_stats().errors[error], 1);
+    }
+
+    using stage_timer = stage_scope;
+
+    inline void count_bytes_read(std::size_t n) { add(global_stats().bytes_read, n); }
+    inline void count_bytes_scanned(std::size_t n) { add(global_stats().bytes_scanned, n); }
+    inline void count_lines(std::size_t n) { add(global_stats().lines, n); }
+    inline void count_keys(std::size_t n) { add(global_stats().keys, n); }
+    inline void count_allocation() { add(global_stats().allocations, 1); }
+#else
+    /**
+     * @brief Nothing to time
+     *
+     */
+    struct stage_timer
+    {
+        explicit stage_timer(parse_stage) {}
+    };
+
+    inline void count_error(ParsingErrorsT) {}
+    inline void count_bytes_read(std::size_t) {}
+    inline void count_bytes_scanned(std::size_t) {}
+    inline void count_lines(std::size_t) {}
+    inline void count_keys(std::size_t) {}
+    inline void count_allocation() {}
+#endif
+
+    template <class E>
+    constexpr bool is_parsing_error(const E& error, ParsingErrorsT& out)
+    {
+        if constexpr (std::is_same_v<E, ParsingErrorsT>)
+        {
+            out = error;
+            return true;
+        }
+        else if constexpr (requires { error.second; } && std::is_same_v<std::remove_cvref_t<decltype(error.second)>, ParsingErrorsT>)
+        {
+            out = error.second;
+            return true;
+        }
+        else
+            return false;
+    }
+
+    /**
+     * @brief Run body as a stage, counting the ParsingErrorsT of its result
+     *
+     * @param stage
+     * @param body returns an expected
+     * @return the result of body
+     */
+    template <class F>
+    decltype(auto) instrument([[maybe_unused]] parse_stage stage, F&& body)
+    {
+#ifdef CLINIARG_INSTRUMENTATION
+        const stage_scope scope(stage);
+        auto res = body();
+        ParsingErrorsT error;
+        if (!res && scope.counts_errors() && is_parsing_error(res.error(), error))
+            count_error(error);
+        return res;
+#else
+        return body();
+#endif
+    }
+} // namespace detail
+
+/**
+ * @brief Current counters, zeros without CLINIARG_INSTRUMENTATION
+ *
+ */
+inline parse_stats stats()
+{
+    parse_stats res;
+#ifdef CLINIARG_INSTRUMENTATION
+    const auto& s = ::detail::global_stats();
+    for (std::size_t i = 0; i < parse_stage_count; ++i)
+    {
+        res.nanoseconds[i] = s.nanoseconds[i].load(std::memory_order_relaxed);
+        res.calls[i] = s.calls[i].load(std::memory_order_relaxed);
+    }
+    res.bytes_read = s.bytes_read.load(std::memory_order_relaxed);
+    res.bytes_scanned = s.bytes_scanned.load(std::memory_order_relaxed);
+    res.lines = s.lines.load(std::memory_order_relaxed);
+    res.keys = s.keys.load(std::memory_order_relaxed);
+    res.allocations = s.allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < parsing_error_count; ++i)
+        res.errors[i] = s.errors[i].load(std::memory_order_relaxed);
+#endif
+    return res;
+}
+
+/**
+ * @brief Set every counter back to zero
+ *
+ */
+inline void reset_stats()
+{
+#ifdef CLINIARG_INSTRUMENTATION
+    auto& s = ::detail::global_stats();
+    for (std::size_t i = 0; i < parse_stage_count; ++i)
+    {
+        s.nanoseconds[i].store(0, std::memory_order_relaxed);
+        s.calls[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto* counter : {&s.bytes_read, &s.bytes_scanned, &s.lines, &s.keys, &s.allocations})
+        counter->store(0, std::memory_order_relaxed);
+    for (auto& counter : s.errors)
+        counter.store(0, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Install the callback called at the end of every outermost stage, nullptr to remove it
+ *
+ * @param callback called on the thread of the stage, must be thread safe
+ */
+inline void set_stage_callback([[maybe_unused]] stage_callback callback)
+{
+#ifdef CLINIARG_INSTRUMENTATION
+    ::detail::global_stats().callback.store(callback, std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Name of a stage, as used in the JSON dump
+ *
+ */
+constexpr const char* stage_name(parse_stage stage)
+{
+    constexpr const char* names[parse_stage_count] = {"read", "tokenize", "split_keyvalue", "parse_value"};
+    return names[static_cast<std::size_t>(stage)];
+}
+
+/**
+ * @brief Name of an error, as used in the JSON dump
+ *
+ */
+constexpr const char* error_name(ParsingErrorsT error)
+{
+    constexpr const char* names[parsing_error_count] = {
+        "keyvaluenotparsed", "keynotfound", "valuenotparsed", "emptyvector", "vectorvaluenotparsed",
+        "sectionnotparsed", "rangenotparsed", "rangezerostep", "rangewrongdirection"};
+    return names[static_cast<std::size_t>(error)];
+}
+
+/**
+ * @brief JSON object of the counters, for logs
+ *
+ *     {"enabled":true,"stages":{"read":{"ns":1200,"calls":1},...},"bytes_read":42,...,"errors":{"keynotfound":1}}
+ *
+ * Only the errors that occurred are listed.
+ *
+ * @param s
+ * @return std::string
+ */
+inline std::string to_json(const parse_stats& s)
+{
+    std::string res = instrumentation_enabled ? "{\"enabled\":true,\"stages\":{" : "{\"enabled\":false,\"stages\":{";
+    for (std::size_t i = 0; i < parse_stage_count; ++i)
+        res.append(i ? ",\"" : "\"").append(stage_name(static_cast<parse_stage>(i)))
+            .append("\":{\"ns\":").append(std::to_string(s.nanoseconds[i]))
+            .append(",\"calls\":").append(std::to_string(s.calls[i])).append("}");
+    res.append("},\"bytes_read\":").append(std::to_string(s.bytes_read))
+        .append(",\"bytes_scanned\":").append(std::to_string(s.bytes_scanned))
+        .append(",\"lines\":").append(std::to_string(s.lines))
+        .append(",\"keys\":").append(std::to_string(s.keys))
+        .append(",\"allocations\":").append(std::to_string(s.allocations))
+        .append(",\"errors\":{");
+    bool first = true;
+    for (std::size_t i = 0; i < parsing_error_count; ++i)
+        if (s.errors[i])
+        {
+            res.append(first ? "\"" : ",\"").append(error_name(static_cast<ParsingErrorsT>(i)))
+                .append("\":").append(std::to_string(s.errors[i]));
+            first = false;
+        }
+    return res.append("}}");
+}
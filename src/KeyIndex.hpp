@@ -0,0 +1,227 @@
+/**
+ * @file KeyIndex.hpp
+ * @brief Allocation-free, compile-time perfect hash of normalized keys
+ *
+ */
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "CliniParser.hpp"
+#include "TrimLower.hpp"
+
+namespace detail
+{
+    /**
+     * @brief FNV-1a hash of the normalized key (as trim_spaces_underscores_andlower), computed on the fly
+     *
+     * @param key raw key
+     * @return std::uint64_t
+     */
+    constexpr std::uint64_t normalized_hash(std::string_view key)
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for (char c : key)
+            if (!to_trim(c))
+            {
+                h ^= static_cast<unsigned char>(to_lower(c));
+                h *= 1099511628211ull;
+            }
+        return h;
+    }
+
+    /**
+     * @brief Compare two keys after normalization, without building them
+     *
+     * @return true same normalized key
+     */
+    constexpr bool normalized_equal(std::string_view lhs, std::string_view rhs)
+    {
+        auto l = lhs.begin();
+        auto r = rhs.begin();
+        for (;;)
+        {
+            while (l != lhs.end() && to_trim(*l))
+                ++l;
+            while (r != rhs.end() && to_trim(*r))
+                ++r;
+            if (l == lhs.end() || r == rhs.end())
+                return l == lhs.end() && r == rhs.end();
+            if (to_lower(*l++) != to_lower(*r++))
+                return false;
+        }
+    }
+
+    /**
+     * @brief Final mix of a 64 bits hash (murmur3 finalizer)
+     *
+     */
+    constexpr std::uint64_t hash_mix(std::uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+} // namespace detail
+
+/**
+ * @brief Perfect hash table of N keys, built at compile time (hash and displace)
+ *
+ * Keys are hashed once, normalized on the fly (spaces and underscores skipped,
+ * ASCII lowercase); the hash selects a bucket whose displacement seed gives a
+ * collision-free slot, then the slot key is compared, again normalized on the fly.
+ * Nothing is allocated and there is no pointer chasing.
+ *
+ * @tparam N number of keys
+ */
+template <std::size_t N>
+class key_index
+{
+public:
+    static constexpr std::size_t buckets = N < 4 ? 1 : std::bit_ceil(N) / 2;
+    static constexpr std::size_t slots = 2 * std::bit_ceil(N == 0 ? 1 : N);
+    static constexpr std::size_t npos = N;
+
+    /**
+     * @brief Build the table, fails to compile on duplicated normalized keys
+     *
+     * @param keys key names, referring to static storage
+     */
+    consteval explicit key_index(const std::array<std::string_view, N>& keys) : m_keys(keys)
+    {
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, buckets + 1> bucket_starts{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = ::detail::normalized_hash(keys[i]);
+            ++bucket_starts[bucket(hashes[i]) + 1];
+        }
+
+        // Keys grouped by bucket (counting sort)
+        for (std::size_t b = 0; b < buckets; ++b)
+            bucket_starts[b + 1] += bucket_starts[b];
+        std::array<std::size_t, N> members{};
+        std::array<std::size_t, buckets> filled{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const std::size_t b = bucket(hashes[i]);
+            members[bucket_starts[b] + filled[b]++] = i;
+        }
+
+        // Place the largest buckets first
+        std::array<std::size_t, buckets> order{};
+        for (std::size_t b = 0; b < buckets; ++b)
+            order[b] = b;
+        for (std::size_t b = 0; b < buckets; ++b)
+            for (std::size_t c = b + 1; c < buckets; ++c)
+                if (filled[order[c]] > filled[order[b]])
+                    std::swap(order[b], order[c]);
+
+        std::array<bool, slots> used{};
+        for (std::size_t b : order)
+        {
+            if (filled[b] == 0)
+                break;
+            const std::size_t first = bucket_starts[b];
+            const std::size_t last = bucket_starts[b + 1];
+            for (std::size_t k = first; k < last; ++k) // equal keys share their bucket
+                for (std::size_t l = first; l < k; ++l)
+                    if (hashes[members[k]] == hashes[members[l]])
+                        throw "key_index: duplicated normalized key (or hash collision)";
+            for (std::uint32_t seed = 1;; ++seed)
+            {
+                if (seed == 1u << 20)
+                    throw "key_index: no displacement found";
+                bool free = true;
+                for (std::size_t k = first; k < last && free; ++k)
+                {
+                    const std::size_t s = slot(hashes[members[k]], seed);
+                    free = !used[s];
+                    for (std::size_t l = first; l < k && free; ++l)
+                        free = slot(hashes[members[l]], seed) != s;
+                }
+                if (free)
+                {
+                    m_seeds[b] = seed;
+                    for (std::size_t k = first; k < last; ++k)
+                    {
+                        used[slot(hashes[members[k]], seed)] = true;
+                        m_slots[slot(hashes[members[k]], seed)] = static_cast<std::uint32_t>(members[k]);
+                    }
+                    break;
+                }
+            }
+        }
+        for (std::size_t s = 0; s < slots; ++s)
+            if (!used[s])
+                m_slots[s] = static_cast<std::uint32_t>(npos);
+    }
+
+    /**
+     * @brief Index of a raw key in the key list
+     *
+     * @param key raw key, normalized on the fly
+     * @return std::size_t npos if the key is unknown
+     */
+    constexpr std::size_t find(std::string_view key) const
+    {
+        const std::uint64_t h = ::detail::normalized_hash(key);
+        const std::size_t index = m_slots[slot(h, m_seeds[bucket(h)])];
+        return index != npos && ::detail::normalized_equal(key, m_keys[index]) ? index : npos;
+    }
+
+    /**
+     * @brief Index of a raw key in the key list
+     *
+     * @param key raw key, normalized on the fly
+     * @return expected<std::size_t, ParsingErrorsT> keynotfound if the key is unknown
+     */
+    expected<std::size_t, ParsingErrorsT> lookup(std::string_view key) const
+    {
+        const std::size_t index = find(key);
+        if (index != npos)
+            return expected<std::size_t, ParsingErrorsT>::success(index);
+        else
+            return expected<std::size_t, ParsingErrorsT>::error(ParsingErrorsT::keynotfound);
+    }
+
+    /**
+     * @brief Key name of an index
+     *
+     */
+    constexpr std::string_view name(std::size_t index) const { return m_keys[index]; }
+
+private:
+    static constexpr std::size_t bucket(std::uint64_t h)
+    {
+        return ::detail::hash_mix(h) & (buckets - 1);
+    }
+
+    static constexpr std::size_t slot(std::uint64_t h, std::uint32_t seed)
+    {
+        return ::detail::hash_mix(h ^ (seed * 0x9e3779b97f4a7c15ull)) & (slots - 1);
+    }
+
+    std::array<std::string_view, N> m_keys{};
+    std::array<std::uint32_t, buckets> m_seeds{};
+    std::array<std::uint32_t, slots> m_slots{};
+};
+
+/**
+ * @brief Build a key_index at compile time from string literals
+ *
+ * @tparam Sizes literal sizes
+ * @param keys
+ * @return key_index<sizeof...(Sizes)>
+ */
+template <std::size_t... Sizes>
+consteval key_index<sizeof...(Sizes)> make_key_index(const char (&... keys)[Sizes])
+{
+    return key_index<sizeof...(Sizes)>({std::string_view(keys, Sizes - 1)...});
+}
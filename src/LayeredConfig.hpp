@@ -0,0 +1,346 @@
+/**
+ * @file LayeredConfig.hpp
+ * @brief Stack of configuration sources (defaults, files, environment, command line)
+ *
+ * Each file or text layer owns its buffer and an ini_index of views into it,
+ * argument and environment layers keep views into argv and environ. A lookup walks
+ * the layers from the last pushed (highest precedence) down to the first, and
+ * returns a view into the layer that has the key: nothing is merged or copied,
+ * and values are only parsed when asked for.
+ */
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Arguments.hpp"
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
+
+#ifndef _WIN32
+extern char** environ;
+#endif
+
+namespace detail
+{
+    /**
+     * @brief Environment block of the process, "NAME=value" strings ended by a null pointer
+     *
+     */
+    inline const char* const* process_environment()
+    {
+#ifdef _WIN32
+        return _environ;
+#else
+        return environ;
+#endif
+    }
+} // namespace detail
+
+/**
+ * @brief One configuration source: an owned buffer and its index, or the
+ * key/value views of arguments or environment variables, which are not copied
+ *
+ */
+class config_layer
+{
+public:
+    /**
+     * @brief INI text, with sections, as ini_index reads it
+     *
+     * @param name layer name, for diagnostics
+     * @param text
+     * @return expected<config_layer, ini_index::error_type>
+     */
+    static expected<config_layer, ini_index::error_type> from_string(std::string name, std::string text)
+    {
+        return make<scan_class::line>(std::move(name), mapped_file(std::move(text)));
+    }
+
+    /**
+     * @brief INI file, mapped with map_file
+     *
+     * @param filename also the layer name
+     * @return expected<config_layer, load_error>
+     */
+    static expected<config_layer, load_error> from_file(const std::string& filename)
+    {
+        auto file = map_file(filename);
+        if (!file)
+            return expected<config_layer, load_error>::error(file.error());
+        auto layer = make<scan_class::line>(filename, std::move(file).get());
+        if (!layer)
+            return expected<config_layer, load_error>::error(layer.error());
+        return expected<config_layer, load_error>::success(std::move(layer).get());
+    }
+
+    /**
+     * @brief Space separated key=value arguments, as split_args reads them
+     *
+     * @param args
+     * @return expected<config_layer, ini_index::error_type>
+     */
+    static expected<config_layer, ini_index::error_type> from_command_line(std::string args)
+    {
+        return make<scan_class::space>("command line", mapped_file(std::move(args)));
+    }
+
+    /**
+     * @brief key=value arguments, one per argv element, so values may contain spaces
+     *
+     * The layer keeps views into the arguments, which must outlive it (those of main do).
+     * offset() of a value is the index of its argument.
+     *
+     * @param args
+     * @return expected<config_layer, argument_error> keyvaluenotparsed for an argument
+     * without key or value, with a line break, or with a blank key or a key starting with '['
+     */
+    static expected<config_layer, argument_error> from_arguments(argument_span args)
+    {
+        config_layer layer("command line");
+        std::size_t position = 0;
+        const auto& checked = for_each_argument(args, [&](std::string_view key, std::string_view value) {
+            const std::string_view trimmed = ::detail::trim_blanks(key);
+            if (trimmed.empty() || trimmed.front() == '[' || key.find_first_of("\r\n") != std::string_view::npos)
+                return expected<void, ParsingErrorsT>::error(ParsingErrorsT::keyvaluenotparsed);
+            while (args[position] != key.data()) // skipped comments and empty arguments
+                ++position;
+            layer.m_views.push_back(view_entry{::detail::normalized_hash(key), key, value, position++});
+            return expected<void, ParsingErrorsT>::success();
+        });
+        if (!checked)
+            return expected<config_layer, argument_error>::error(checked.error());
+        return expected<config_layer, argument_error>::success(std::move(layer));
+    }
+
+    /**
+     * @brief Environment variables named prefix + key, the prefix removed
+     *
+     * Variables with an empty key or value, a key starting with '[' or a line break
+     * in their value are skipped, those starting with '#' or '%' are comments.
+     * The keys are normalized as the others: "APP_ONE_INT" gives the key oneint for prefix "APP_".
+     *
+     * The layer keeps views into the environment strings, which must outlive it:
+     * setenv and putenv may replace them. offset() of a value is the index of its variable.
+     *
+     * @param prefix
+     * @param environment "NAME=value" strings ended by a null pointer, the process environment by default
+     * @return config_layer
+     */
+    static config_layer from_environment(std::string_view prefix,
+                                         const char* const* environment = ::detail::process_environment())
+    {
+        config_layer layer("environment");
+        for (const char* const* var = environment; var && *var; ++var)
+        {
+            const std::string_view entry(*var);
+            if (entry.substr(0, prefix.size()) != prefix)
+                continue;
+            const std::string_view kv = entry.substr(prefix.size());
+            const auto equal = kv.find('=');
+            if (equal == std::string_view::npos || equal + 1 == kv.size()
+                || ::detail::trim_blanks(kv.substr(0, equal)).empty()
+                || ::detail::trim_blanks(kv.substr(0, equal)).front() == '[' // would be a section header
+                || kv.find_first_of("\r\n") != std::string_view::npos)
+                continue;
+            const std::string_view key = kv.substr(0, equal);
+            layer.m_views.push_back(view_entry{::detail::normalized_hash(key), key, kv.substr(equal + 1),
+                                               static_cast<std::size_t>(var - environment)});
+        }
+        return layer;
+    }
+
+    /**
+     * @brief Raw value of the last occurrence of key in section
+     *
+     */
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) const
+    {
+        if (m_buffer)
+            return m_index.find(section, key);
+        if (!::detail::normalized_equal(section, {}))
+            return std::nullopt;
+        const std::uint64_t hash = ::detail::normalized_hash(key);
+        for (auto it = m_views.rbegin(); it != m_views.rend(); ++it) // last occurrence first
+            if (it->hash == hash && ::detail::normalized_equal(it->key, key))
+                return it->value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Offset of a value returned by find() in the layer buffer, or index
+     * of its argument or variable for the layers without buffer
+     *
+     */
+    std::size_t offset(std::string_view value) const noexcept
+    {
+        if (m_buffer)
+            return value.data() - m_index.source().data();
+        const auto it = std::find_if(m_views.begin(), m_views.end(), [&](const view_entry& e) { return e.value.data() == value.data(); });
+        return it == m_views.end() ? 0 : it->position;
+    }
+
+    /**
+     * @brief Number of key/value entries, duplicates included
+     *
+     */
+    std::size_t size() const noexcept { return m_buffer ? m_index.size() : m_views.size(); }
+
+    const std::string& name() const noexcept { return m_name; }
+
+    /**
+     * @brief Index of the buffer, empty for the layers of arguments or variables
+     *
+     */
+    const ini_index& index() const noexcept { return m_index; }
+
+private:
+    /**
+     * @brief Key/value of an argument or variable
+     *
+     */
+    struct view_entry
+    {
+        std::uint64_t hash; // normalized key
+        std::string_view key;
+        std::string_view value;
+        std::size_t position; // index of the argument or variable
+    };
+
+    config_layer(std::string name, std::unique_ptr<mapped_file> buffer, ini_index index)
+        : m_name(std::move(name)), m_buffer(std::move(buffer)), m_index(std::move(index)) {}
+
+    explicit config_layer(std::string name)
+        : m_name(std::move(name)), m_index(std::move(ini_index::build(std::string_view{})).get()) {}
+
+    /**
+     * @brief Index a buffer, kept on the heap so that the views survive the moves of the layer
+     *
+     */
+    template <scan_class Class>
+    static expected<config_layer, ini_index::error_type> make(std::string name, mapped_file buffer)
+    {
+        auto owned = std::make_unique<mapped_file>(std::move(buffer));
+        auto index = ini_index::build<Class>(owned->view());
+        if (!index)
+            return expected<config_layer, ini_index::error_type>::error(index.error());
+        return expected<config_layer, ini_index::error_type>::success(config_layer(std::move(name), std::move(owned), std::move(index).get()));
+    }
+
+    std::string m_name;
+    std::unique_ptr<mapped_file> m_buffer; // null for the layers of views
+    ini_index m_index;
+    std::vector<view_entry> m_views;
+};
+
+/**
+ * @brief Error of layered_config::load: layer index, offset in the layer and error
+ *
+ */
+struct layered_error
+{
+    std::size_t layer;
+    std::size_t offset;
+    ParsingErrorsT error;
+};
+
+/**
+ * @brief Configuration sources by increasing precedence
+ *
+ */
+class layered_config
+{
+public:
+    /**
+     * @brief Add a layer above the existing ones
+     *
+     * @param layer
+     * @return layered_config&
+     */
+    layered_config& push(config_layer layer)
+    {
+        m_layers.push_back(std::move(layer));
+        return *this;
+    }
+
+    /**
+     * @brief Raw value of key in section, from the highest layer that has it
+     *
+     * @param section section name, "" for the keys outside of any section
+     * @param key
+     * @return std::optional<std::string_view> a view into the layer buffer
+     */
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) const
+    {
+        if (const auto& found = find_layer(section, key))
+            return found->second;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Parse the value of key in section, from the highest layer that has it, as parse_as<ValueT>
+     *
+     * @tparam ValueT
+     * @param section
+     * @param key
+     * @return expected<ValueT, ParsingErrorsT> keynotfound if no layer has the key
+     */
+    template <class ValueT>
+    expected<ValueT, ParsingErrorsT> get(std::string_view section, std::string_view key) const
+    {
+        const auto& value = find(section, key);
+        if (!value)
+        {
+            ::detail::count_error(ParsingErrorsT::keynotfound);
+            return expected<ValueT, ParsingErrorsT>::error(ParsingErrorsT::keynotfound);
+        }
+        return parse_as<ValueT>(*value);
+    }
+
+    /**
+     * @brief Index of the highest layer that has key in section, and the raw value
+     *
+     * @return std::optional<std::pair<std::size_t, std::string_view>>
+     */
+    std::optional<std::pair<std::size_t, std::string_view>> find_layer(std::string_view section, std::string_view key) const
+    {
+        for (std::size_t layer = m_layers.size(); layer-- > 0;)
+            if (const auto& value = m_layers[layer].find(section, key))
+                return std::pair{layer, *value};
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Assign the fields of a schema from one section, each from the highest layer that has it
+     *
+     * @tparam Schema schema<...> of the properties
+     * @param props
+     * @param section
+     * @return expected<void, layered_error> stopping at the first value in error
+     */
+    template <class Schema>
+    expected<void, layered_error> load(typename Schema::properties_type& props, std::string_view section = {}) const
+    {
+        for (std::size_t index = 0; index < Schema::size; ++index)
+            if (const auto& found = find_layer(section, Schema::keys.name(index)))
+            {
+                const auto& res = Schema::assign_field(props, index, found->second);
+                if (!res)
+                    return expected<void, layered_error>::error(
+                        layered_error{found->first, m_layers[found->first].offset(found->second), res.error()});
+            }
+        return expected<void, layered_error>::success();
+    }
+
+    std::size_t size() const noexcept { return m_layers.size(); }
+    const config_layer& layer(std::size_t index) const { return m_layers[index]; }
+
+private:
+    std::vector<config_layer> m_layers;
+};
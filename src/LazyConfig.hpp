@@ -0,0 +1,246 @@
+/**
+ * @file LazyConfig.hpp
+ * @brief Configuration document parsed on demand, one value at a time
+ *
+ * Opening a lazy_config makes one pass over the buffer, recording for each key
+ * the hash of its normalized (section, key) and the offset and length of its
+ * value in an open addressing table: no value is parsed and nothing is sorted.
+ * A value is parsed with parse_as the first time it is read with get<T>, and
+ * the typed result is kept, so that the cost of a load follows the keys that
+ * are read rather than the file size.
+ */
+#pragma once
+#include <algorithm>
+#include <any>
+#include <bit>
+#include <cstdint>
+#include <forward_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
+#include "Scanner.hpp"
+#include "Schema.hpp"
+
+/**
+ * @brief Indexed INI buffer with a per key cache of the parsed values
+ *
+ * As with ini_index, "[section]" lines open a section and the last occurrence
+ * of a key wins. get<T> fills the cache: a lazy_config is not shared between
+ * threads without locking.
+ */
+class lazy_config
+{
+public:
+    /**
+     * @brief Error payload: input offset and error
+     *
+     */
+    using error_type = std::pair<std::size_t, ParsingErrorsT>;
+
+    /**
+     * @brief Index an INI text, with sections
+     *
+     * @param text
+     * @return expected<lazy_config, error_type> stopping at the first malformed
+     * entry (keyvaluenotparsed, sectionnotparsed)
+     */
+    static expected<lazy_config, error_type> from_string(std::string text)
+    {
+        return build(mapped_file(std::move(text)));
+    }
+
+    /**
+     * @brief Map and index an INI file
+     *
+     * @param filename
+     * @return expected<lazy_config, load_error>
+     */
+    static expected<lazy_config, load_error> from_file(const std::string& filename)
+    {
+        auto file = map_file(filename);
+        if (!file)
+            return expected<lazy_config, load_error>::error(file.error());
+        auto config = build(std::move(file).get());
+        if (!config)
+            return expected<lazy_config, load_error>::error(config.error());
+        return expected<lazy_config, load_error>::success(std::move(config).get());
+    }
+
+    /**
+     * @brief Value of key in section, parsed as parse_as<ValueT> on first access
+     *
+     * The pointer stays valid as long as the lazy_config. A value read with
+     * several types is parsed and kept once per type, errors are not kept.
+     *
+     * @tparam ValueT
+     * @param section section name, "" for the keys outside of any section
+     * @param key
+     * @return expected<const ValueT*, ParsingErrorsT> keynotfound, or the parsing error
+     */
+    template <class ValueT>
+    expected<const ValueT*, ParsingErrorsT> get(std::string_view section, std::string_view key)
+    {
+        using result_t = expected<const ValueT*, ParsingErrorsT>;
+        const auto& position = find_position(section, key);
+        if (!position)
+        {
+            ::detail::count_error(ParsingErrorsT::keynotfound);
+            return result_t::error(ParsingErrorsT::keynotfound);
+        }
+
+        auto& cached = m_cache[*position];
+        for (const std::any& value : cached)
+            if (const ValueT* typed = std::any_cast<ValueT>(&value))
+                return result_t::success(typed);
+
+        auto parsed = parse_as<ValueT>(text(m_entries[*position].value));
+        if (!parsed)
+            return result_t::error(parsed.error());
+        cached.emplace_front(std::in_place_type<ValueT>, std::move(parsed).get());
+        ++m_parsed;
+        return result_t::success(std::any_cast<ValueT>(&cached.front()));
+    }
+
+    /**
+     * @brief get(section, key) for the keys outside of any section
+     *
+     */
+    template <class ValueT>
+    expected<const ValueT*, ParsingErrorsT> get(std::string_view key)
+    {
+        return get<ValueT>({}, key);
+    }
+
+    /**
+     * @brief Raw value of key in section, nothing parsed
+     *
+     */
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) const
+    {
+        const auto& position = find_position(section, key);
+        if (!position)
+            return std::nullopt;
+        return text(m_entries[*position].value);
+    }
+
+    /**
+     * @brief Number of distinct keys
+     *
+     */
+    std::size_t size() const noexcept { return m_entries.size(); }
+
+    /**
+     * @brief Number of values parsed and kept so far
+     *
+     */
+    std::size_t parsed() const noexcept { return m_parsed; }
+
+    /**
+     * @brief Indexed buffer
+     *
+     */
+    std::string_view source() const noexcept { return m_buffer.view(); }
+
+private:
+    using span_t = ::detail::text_span;
+
+    struct entry
+    {
+        std::uint64_t hash;
+        span_t key;
+        span_t value;
+        std::uint32_t section;
+    };
+
+    explicit lazy_config(mapped_file buffer) : m_buffer(std::move(buffer)), m_sections{span_t{0, 0}} {}
+
+    static expected<lazy_config, error_type> build(mapped_file buffer)
+    {
+        lazy_config config(std::move(buffer));
+        const std::string_view source = config.source();
+        config.m_slots.assign(std::bit_ceil(source.size() / 32 + 16), 0);
+
+        const auto& error = ::detail::for_each_entry<scan_class::line>(source,
+            [&](std::string_view section) { config.m_sections.push_back(config.span(section)); },
+            [&](std::uint32_t section, std::string_view key, std::string_view value) { config.insert(section, key, value); });
+        if (error)
+            return expected<lazy_config, error_type>::error(*error);
+        config.m_cache.resize(config.m_entries.size());
+        return expected<lazy_config, error_type>::success(std::move(config));
+    }
+
+    span_t span(std::string_view str) const { return span_t::of(source(), str); }
+    std::string_view text(span_t s) const { return s.in(source()); }
+
+    bool same_key(const entry& e, std::uint64_t hash, std::string_view section, std::string_view key) const
+    {
+        return e.hash == hash && ::detail::normalized_equal(text(e.key), key)
+            && ::detail::normalized_equal(text(m_sections[e.section]), section);
+    }
+
+    /**
+     * @brief Add a key, or replace the value of an earlier occurrence
+     *
+     */
+    void insert(std::uint32_t section, std::string_view key, std::string_view value)
+    {
+        const std::uint64_t hash = ::detail::section_key_hash(text(m_sections[section]), key);
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            if (m_slots[slot] == 0)
+            {
+                m_entries.push_back(entry{hash, span(key), span(value), section});
+                m_slots[slot] = static_cast<std::uint32_t>(m_entries.size());
+                if (m_entries.size() * 2 > m_slots.size())
+                    grow();
+                return;
+            }
+            entry& e = m_entries[m_slots[slot] - 1];
+            if (same_key(e, hash, text(m_sections[section]), key))
+            {
+                e.value = span(value);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Double the table, keeping it at most half full
+     *
+     */
+    void grow()
+    {
+        m_slots.assign(m_slots.size() * 2, 0);
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            std::size_t slot = m_entries[i].hash & mask;
+            while (m_slots[slot] != 0)
+                slot = (slot + 1) & mask;
+            m_slots[slot] = static_cast<std::uint32_t>(i + 1);
+        }
+    }
+
+    std::optional<std::size_t> find_position(std::string_view section, std::string_view key) const
+    {
+        const std::uint64_t hash = ::detail::section_key_hash(section, key);
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t slot = hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask)
+            if (same_key(m_entries[m_slots[slot] - 1], hash, section, key))
+                return m_slots[slot] - 1;
+        return std::nullopt;
+    }
+
+    mapped_file m_buffer;
+    std::vector<span_t> m_sections;
+    std::vector<std::uint32_t> m_slots; // entry index + 1, 0 for an empty slot
+    std::vector<entry> m_entries;
+    std::vector<std::forward_list<std::any>> m_cache; // one list per entry, its nodes never move
+    std::size_t m_parsed = 0;
+};
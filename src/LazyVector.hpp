@@ -0,0 +1,309 @@
+/**
+ * @file LazyVector.hpp
+ * @brief Vector values with range notation, kept as arithmetic progressions
+ *
+ * A value is a comma separated list of numbers and of "start:stop" or
+ * "start:stop:step" ranges, the stop included:
+ *
+ *     sweep=1,2,5:10,20:100:10,0.5
+ *
+ * lazy_vector_parse stores each range (and each run of equally spaced numbers)
+ * as one (start, step, count) segment: the elements are computed on access,
+ * and to_vector() materializes them only when asked for.
+ */
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "CliniParser.hpp"
+
+namespace detail
+{
+    template <class ValueT>
+    struct range_step
+    {
+        using type = ValueT;
+    };
+
+    template <std::integral ValueT>
+    struct range_step<ValueT>
+    {
+        using type = std::make_signed_t<ValueT>;
+    };
+} // namespace detail
+
+/**
+ * @brief Random access, read-only sequence of arithmetic progressions
+ *
+ * @tparam ValueT arithmetic type handled by std::from_chars
+ */
+template <::detail::from_chars_arithmetic ValueT>
+class lazy_vector
+{
+public:
+    using value_type = ValueT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * @brief Type of the steps: signed, so that unsigned ranges may go down
+     *
+     */
+    using step_type = typename ::detail::range_step<ValueT>::type;
+
+    class iterator
+    {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ValueT;
+        using difference_type = std::ptrdiff_t;
+        using reference = ValueT;
+
+        iterator() = default;
+        iterator(const lazy_vector* vec, std::size_t index) : m_vec(vec), m_index(index) {}
+
+        ValueT operator*() const { return (*m_vec)[m_index]; }
+        ValueT operator[](difference_type n) const { return (*m_vec)[m_index + n]; }
+
+        iterator& operator++() { ++m_index; return *this; }
+        iterator operator++(int) { auto it = *this; ++m_index; return it; }
+        iterator& operator--() { --m_index; return *this; }
+        iterator operator--(int) { auto it = *this; --m_index; return it; }
+        iterator& operator+=(difference_type n) { m_index += n; return *this; }
+        iterator& operator-=(difference_type n) { m_index -= n; return *this; }
+
+        friend iterator operator+(iterator it, difference_type n) { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.m_index == b.m_index; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a.m_index <=> b.m_index; }
+
+    private:
+        const lazy_vector* m_vec = nullptr;
+        std::size_t m_index = 0;
+    };
+
+    /**
+     * @brief Append count elements start, start + step, ..., merged into the last
+     * segment when they continue it
+     *
+     * @param start
+     * @param step
+     * @param count
+     */
+    void append(ValueT start, step_type step, std::size_t count)
+    {
+        if (count == 0)
+            return;
+        if (!m_segments.empty() && (count == 1 || std::is_integral_v<ValueT>)) // merging floating ranges would round differently
+        {
+            segment& last = m_segments.back();
+            const step_type continued = last.count == 1 ? difference(start, last.start) : last.step;
+            if ((count == 1 || step == continued) && last.element(last.count, continued) == start)
+            {
+                last.step = continued;
+                last.count += count;
+                m_ends.back() += count;
+                return;
+            }
+        }
+        m_segments.push_back(segment{start, step, count});
+        m_ends.push_back(size() + count);
+    }
+
+    std::size_t size() const noexcept { return m_ends.empty() ? 0 : m_ends.back(); }
+    bool empty() const noexcept { return m_ends.empty(); }
+
+    /**
+     * @brief Number of stored progressions
+     *
+     */
+    std::size_t segments() const noexcept { return m_segments.size(); }
+
+    /**
+     * @brief Element at index, computed from its segment (binary search over the segments)
+     *
+     */
+    ValueT operator[](std::size_t index) const
+    {
+        const std::size_t s = std::upper_bound(m_ends.begin(), m_ends.end(), index) - m_ends.begin();
+        return m_segments[s].element(index - (m_ends[s] - m_segments[s].count));
+    }
+
+    ValueT front() const { return m_segments.front().start; }
+    ValueT back() const { return m_segments.back().element(m_segments.back().count - 1); }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+
+    /**
+     * @brief Materialize the elements
+     *
+     * @return std::vector<ValueT>
+     */
+    std::vector<ValueT> to_vector() const
+    {
+        std::vector<ValueT> res;
+        res.reserve(size());
+        for (const segment& s : m_segments)
+            for (std::size_t i = 0; i < s.count; ++i)
+                res.push_back(s.element(i));
+        return res;
+    }
+
+private:
+    struct segment
+    {
+        ValueT start;
+        step_type step;
+        std::size_t count;
+
+        ValueT element(std::size_t i) const { return element(i, step); }
+
+        /**
+         * @brief start + i * step, with the integer arithmetic done modulo 2^N
+         * so that it never overflows when the result is representable
+         *
+         */
+        ValueT element(std::size_t i, step_type step) const
+        {
+            if constexpr (std::is_integral_v<ValueT>)
+            {
+                using unsigned_type = std::make_unsigned_t<ValueT>;
+                return static_cast<ValueT>(static_cast<unsigned_type>(static_cast<unsigned_type>(start)
+                                           + static_cast<unsigned_type>(i) * static_cast<unsigned_type>(step)));
+            }
+            else
+                return start + static_cast<ValueT>(i) * step;
+        }
+    };
+
+    static step_type difference(ValueT to, ValueT from)
+    {
+        if constexpr (std::is_integral_v<ValueT>)
+        {
+            using unsigned_type = std::make_unsigned_t<ValueT>;
+            return static_cast<step_type>(static_cast<unsigned_type>(static_cast<unsigned_type>(to) - static_cast<unsigned_type>(from)));
+        }
+        else
+            return to - from;
+    }
+
+    std::vector<segment> m_segments;
+    std::vector<std::size_t> m_ends; // cumulated counts, one per segment
+};
+
+namespace detail
+{
+    /**
+     * @brief Number of elements of start:stop:step, the stop included
+     *
+     * @return expected<std::size_t, ParsingErrorsT> rangezerostep, rangewrongdirection
+     * if step goes away from stop, rangenotparsed if the count does not fit
+     */
+    template <class ValueT, class StepT>
+    expected<std::size_t, ParsingErrorsT> range_count(ValueT start, ValueT stop, StepT step)
+    {
+        if (step == 0)
+            return expected<std::size_t, ParsingErrorsT>::error(ParsingErrorsT::rangezerostep);
+        if (start != stop && (stop > start) != (step > 0))
+            return expected<std::size_t, ParsingErrorsT>::error(ParsingErrorsT::rangewrongdirection);
+        if constexpr (std::is_integral_v<ValueT>)
+        {
+            using unsigned_type = std::make_unsigned_t<ValueT>;
+            const unsigned_type distance = stop > start ? static_cast<unsigned_type>(static_cast<unsigned_type>(stop) - static_cast<unsigned_type>(start))
+                                                        : static_cast<unsigned_type>(static_cast<unsigned_type>(start) - static_cast<unsigned_type>(stop));
+            const unsigned_type magnitude = step > 0 ? static_cast<unsigned_type>(step) : static_cast<unsigned_type>(unsigned_type{0} - static_cast<unsigned_type>(step));
+            const unsigned_type steps = distance / magnitude;
+            if (steps >= std::numeric_limits<std::size_t>::max())
+                return expected<std::size_t, ParsingErrorsT>::error(ParsingErrorsT::rangenotparsed);
+            return expected<std::size_t, ParsingErrorsT>::success(static_cast<std::size_t>(steps) + 1);
+        }
+        else
+        {
+            // a little tolerance, so that 0:0.3:0.1 has its 4 elements despite the rounding
+            const ValueT steps = std::floor((stop - start) / step * (1 + 64 * std::numeric_limits<ValueT>::epsilon()));
+            if (!(steps >= 0 && steps < static_cast<ValueT>(std::numeric_limits<std::ptrdiff_t>::max())))
+                return expected<std::size_t, ParsingErrorsT>::error(ParsingErrorsT::rangenotparsed);
+            return expected<std::size_t, ParsingErrorsT>::success(static_cast<std::size_t>(steps) + 1);
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Parse numbers and start:stop[:step] ranges, comma separated, into a lazy_vector
+ *
+ * Empty elements are skipped, as with vector_parse. The step defaults to 1
+ * and the stop is included when it falls on a step.
+ *
+ * @tparam ValueT arithmetic type handled by std::from_chars
+ * @param str
+ * @return expected<lazy_vector<ValueT>, ParsingErrorsT> emptyvector, vectorvaluenotparsed
+ * for a number in error, rangenotparsed for a malformed range, rangezerostep, rangewrongdirection
+ */
+template <::detail::from_chars_arithmetic ValueT>
+expected<lazy_vector<ValueT>, ParsingErrorsT> lazy_vector_parse(std::string_view str)
+{
+    return ::detail::instrument(parse_stage::parse_value, [&] {
+        using result_t = expected<lazy_vector<ValueT>, ParsingErrorsT>;
+        using step_type = typename lazy_vector<ValueT>::step_type;
+
+        lazy_vector<ValueT> res;
+        for (std::size_t first = 0; first < str.size();)
+        {
+            const std::size_t last = std::min(str.find(',', first), str.size());
+            const std::string_view element = str.substr(first, last - first);
+            first = last + 1;
+            if (element.empty())
+                continue;
+
+            const std::size_t colon = element.find(':');
+            if (colon == std::string_view::npos)
+            {
+                const auto& value = ::detail::from_chars_parse<ValueT>(element.data(), element.data() + element.size());
+                if (!value)
+                    return result_t::error(ParsingErrorsT::vectorvaluenotparsed);
+                res.append(value.get(), 0, 1);
+                continue;
+            }
+
+            const std::size_t second_colon = element.find(':', colon + 1);
+            const std::string_view start_str = element.substr(0, colon);
+            const std::string_view stop_str = element.substr(colon + 1, second_colon == std::string_view::npos ? std::string_view::npos : second_colon - colon - 1);
+            const std::string_view step_str = second_colon == std::string_view::npos ? std::string_view{} : element.substr(second_colon + 1);
+            if (second_colon != std::string_view::npos && (step_str.empty() || step_str.find(':') != std::string_view::npos))
+                return result_t::error(ParsingErrorsT::rangenotparsed);
+
+            const auto& start = ::detail::from_chars_parse<ValueT>(start_str.data(), start_str.data() + start_str.size());
+            const auto& stop = ::detail::from_chars_parse<ValueT>(stop_str.data(), stop_str.data() + stop_str.size());
+            const auto& step = step_str.empty() ? expected<step_type, ParsingErrorsT>::success(1)
+                                                : ::detail::from_chars_parse<step_type>(step_str.data(), step_str.data() + step_str.size());
+            if (!start || !stop || !step)
+                return result_t::error(ParsingErrorsT::rangenotparsed);
+
+            const auto& count = ::detail::range_count(start.get(), stop.get(), step.get());
+            if (!count)
+                return result_t::error(count.error());
+            res.append(start.get(), step.get(), count.get());
+        }
+
+        if (res.empty())
+            return result_t::error(ParsingErrorsT::emptyvector);
+        ::detail::count_allocation();
+        return result_t::success(std::move(res));
+    });
+}
@@ -0,0 +1,393 @@
+/**
+ * @file LiveConfig.hpp
+ * @brief Configuration reloaded in the background, read through immutable snapshots
+ *
+ * Unlike Singleton<Properties>, which hands out one mutable object, a
+ * live_config never modifies a published Properties: a reload parses the file
+ * into a new one and publishes it with an atomic pointer swap (RCU-style).
+ * Readers keep a consistent snapshot for as long as they hold it, and a
+ * snapshot_reader only pays one atomic load per access while nothing changes.
+ */
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "MappedFile.hpp"
+#include "ParallelParser.hpp"
+#include "Schema.hpp"
+
+#ifdef __linux__
+#define CLINIARG_HAS_INOTIFY
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Error of a reload
+ *
+ */
+using reload_error = load_error;
+
+/**
+ * @brief Atomically published immutable value
+ *
+ * @tparam T
+ */
+template <class T>
+class snapshot_cell
+{
+public:
+    explicit snapshot_cell(T value) : m_current(std::make_shared<const T>(std::move(value))) {}
+
+    /**
+     * @brief Current snapshot, valid as long as it is held whatever the later publications
+     *
+     * @return std::shared_ptr<const T>
+     */
+    std::shared_ptr<const T> load() const
+    {
+#ifdef __cpp_lib_atomic_shared_ptr
+        return m_current.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+#endif
+    }
+
+    /**
+     * @brief Replace the current snapshot
+     *
+     * @param value
+     */
+    void publish(T value)
+    {
+        auto snapshot = std::make_shared<const T>(std::move(value));
+#ifdef __cpp_lib_atomic_shared_ptr
+        m_current.store(std::move(snapshot), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_current, std::move(snapshot), std::memory_order_release);
+#endif
+        m_version.fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of publications, incremented after the snapshot is swapped
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t version() const noexcept { return m_version.load(std::memory_order_acquire); }
+
+private:
+#ifdef __cpp_lib_atomic_shared_ptr
+    std::atomic<std::shared_ptr<const T>> m_current;
+#else
+    std::shared_ptr<const T> m_current;
+#endif
+    std::atomic<std::uint64_t> m_version{0};
+};
+
+/**
+ * @brief Per thread cached access to a snapshot_cell: the snapshot is only
+ * reloaded when the cell version changes
+ *
+ * A reader is not shared between threads, each thread owns its own.
+ *
+ * @tparam T
+ */
+template <class T>
+class snapshot_reader
+{
+public:
+    /**
+     * @brief Read from cell, which must outlive the reader
+     *
+     * @param cell
+     */
+    explicit snapshot_reader(const snapshot_cell<T>& cell)
+        : m_cell(&cell), m_version(cell.version()), m_snapshot(cell.load()) {}
+
+    /**
+     * @brief Latest snapshot, valid until the next call
+     *
+     * @return const T&
+     */
+    const T& get()
+    {
+        const std::uint64_t version = m_cell->version();
+        if (version != m_version)
+        {
+            m_version = version;
+            m_snapshot = m_cell->load();
+        }
+        return *m_snapshot;
+    }
+
+    const T& operator*() { return get(); }
+    const T* operator->() { return &get(); }
+
+private:
+    const snapshot_cell<T>* m_cell;
+    std::uint64_t m_version;
+    std::shared_ptr<const T> m_snapshot;
+};
+
+/**
+ * @brief Configuration file loaded into a schema, reloaded when the file changes
+ *
+ * Every reload starts again from the defaults, so that a key removed from the
+ * file gets back its default value. A failed reload keeps the current snapshot.
+ * The file is watched with inotify on Linux (its directory is watched, so that
+ * editors replacing the file are seen), by polling its modification time elsewhere
+ * or when inotify cannot be set up (no instance or watch left, unreadable directory).
+ *
+ * @tparam Schema schema<...> of the properties
+ */
+template <class Schema>
+class live_config
+{
+public:
+    using properties_type = typename Schema::properties_type;
+
+    static constexpr std::chrono::milliseconds default_poll_interval{500};
+
+    /**
+     * @brief Load filename, then watch it if asked to
+     *
+     * A failed initial load publishes the defaults and is reported by last_error().
+     *
+     * @param filename
+     * @param defaults values of the keys absent from the file
+     * @param watch reload in a background thread when the file changes
+     * @param poll_interval period of the modification time checks, where inotify is not available
+     */
+    explicit live_config(std::string filename, properties_type defaults = {}, bool watch = true,
+                         std::chrono::milliseconds poll_interval = default_poll_interval)
+        : m_filename(std::move(filename)), m_defaults(std::move(defaults)), m_cell(m_defaults), m_poll_interval(poll_interval)
+    {
+        reload();
+        if (watch)
+            start_watching();
+    }
+
+    live_config(const live_config&) = delete;
+    live_config& operator=(const live_config&) = delete;
+
+    ~live_config()
+    {
+        stop_watching();
+    }
+
+    /**
+     * @brief Parse the file and publish the result
+     *
+     * @return expected<void, reload_error> the error is also kept as last_error()
+     */
+    expected<void, reload_error> reload()
+    {
+        std::lock_guard lock(m_reload_mutex);
+        auto res = load();
+        if (res)
+            m_last_error.reset();
+        else
+            m_last_error = res.error();
+        return res;
+    }
+
+    /**
+     * @brief Current configuration, immutable
+     *
+     * @return std::shared_ptr<const properties_type>
+     */
+    std::shared_ptr<const properties_type> snapshot() const { return m_cell.load(); }
+
+    /**
+     * @brief Cached access for one thread, see snapshot_reader
+     *
+     * @return snapshot_reader<properties_type>
+     */
+    snapshot_reader<properties_type> reader() const { return snapshot_reader<properties_type>(m_cell); }
+
+    /**
+     * @brief Number of successful reloads, the initial load included
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t version() const noexcept { return m_cell.version(); }
+
+    /**
+     * @brief Error of the last reload, if it failed
+     *
+     * @return std::optional<reload_error>
+     */
+    std::optional<reload_error> last_error() const
+    {
+        std::lock_guard lock(m_reload_mutex);
+        return m_last_error;
+    }
+
+    /**
+     * @brief Watched file
+     *
+     */
+    const std::string& filename() const noexcept { return m_filename; }
+
+private:
+    expected<void, reload_error> load()
+    {
+        const auto& file = map_file(m_filename);
+        if (!file)
+            return expected<void, reload_error>::error(file.error());
+        const std::string_view content = file.get().view();
+
+        auto chunk = ::detail::parse_chunk<Schema>(content, 0, content.size());
+        if (chunk.error)
+            return expected<void, reload_error>::error(*chunk.error);
+        properties_type props = m_defaults;
+        Schema::merge(props, chunk.props, chunk.assigned);
+        m_cell.publish(std::move(props));
+        return expected<void, reload_error>::success();
+    }
+
+    /**
+     * @brief Watch the file with inotify where available, falling back to polling
+     * its modification time when there is no inotify or it cannot be set up
+     *
+     */
+    void start_watching()
+    {
+#ifdef CLINIARG_HAS_INOTIFY
+        if (start_inotify())
+            return;
+#endif
+        // the first modification time is taken here, so that a change before the thread starts is seen
+        std::error_code ec;
+        m_watcher = std::thread([this, last = std::filesystem::last_write_time(m_filename, ec)] { poll_file(last); });
+    }
+
+    void stop_watching()
+    {
+        if (m_watcher.joinable())
+        {
+            {
+                std::lock_guard lock(m_stop_mutex);
+                m_stop = true;
+            }
+            m_stop_condition.notify_one();
+#ifdef CLINIARG_HAS_INOTIFY
+            if (m_stop_pipe[1] >= 0)
+                (void)!::write(m_stop_pipe[1], "", 1);
+#endif
+            m_watcher.join();
+        }
+#ifdef CLINIARG_HAS_INOTIFY
+        for (int fd : {m_stop_pipe[0], m_stop_pipe[1], m_inotify})
+            if (fd >= 0)
+                ::close(fd);
+#endif
+    }
+
+    /**
+     * @brief Reload when the modification time changes, until stopped
+     *
+     * @param last modification time of the loaded file
+     */
+    void poll_file(std::filesystem::file_time_type last)
+    {
+        std::error_code ec;
+        std::unique_lock lock(m_stop_mutex);
+        while (!m_stop_condition.wait_for(lock, m_poll_interval, [this] { return m_stop; }))
+        {
+            const auto time = std::filesystem::last_write_time(m_filename, ec);
+            if (!ec && time != last)
+            {
+                last = time;
+                reload();
+            }
+        }
+    }
+
+#ifdef CLINIARG_HAS_INOTIFY
+    /**
+     * @brief Start the inotify watcher thread
+     *
+     * @return false if inotify or the stop pipe could not be set up, nothing left open
+     */
+    bool start_inotify()
+    {
+        const std::filesystem::path path(m_filename);
+        const std::filesystem::path dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotify < 0)
+            return false;
+        if (::inotify_add_watch(m_inotify, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0 || ::pipe2(m_stop_pipe, O_CLOEXEC) != 0)
+        {
+            ::close(m_inotify);
+            m_inotify = -1;
+            m_stop_pipe[0] = m_stop_pipe[1] = -1;
+            return false;
+        }
+        m_watcher = std::thread([this, name = path.filename().string()] { watch(name); });
+        return true;
+    }
+
+    /**
+     * @brief Reload once per batch of events naming the file, until the stop pipe is written
+     *
+     * @param name file name in the watched directory
+     */
+    void watch(const std::string& name)
+    {
+        alignas(inotify_event) char events[4096];
+        pollfd fds[2] = {{m_inotify, POLLIN, 0}, {m_stop_pipe[0], POLLIN, 0}};
+        for (;;)
+        {
+            if (::poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            if (fds[1].revents)
+                return;
+
+            bool changed = false;
+            ssize_t n;
+            while ((n = ::read(m_inotify, events, sizeof(events))) > 0)
+                for (const char* p = events; p < events + n;)
+                {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    changed |= event->len > 0 && name == event->name;
+                    p += sizeof(inotify_event) + event->len;
+                }
+            if (changed)
+                reload();
+        }
+    }
+
+    int m_inotify = -1;
+    int m_stop_pipe[2] = {-1, -1};
+#endif
+
+    std::mutex m_stop_mutex;
+    std::condition_variable m_stop_condition;
+    bool m_stop = false;
+
+    const std::string m_filename;
+    const properties_type m_defaults;
+    snapshot_cell<properties_type> m_cell;
+    std::chrono::milliseconds m_poll_interval;
+    mutable std::mutex m_reload_mutex;
+    std::optional<reload_error> m_last_error;
+    std::thread m_watcher;
+};
@@ -0,0 +1,216 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Zero-copy file access through a read-only memory mapping
+ *
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "CliniParser.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CLINIARG_HAS_MMAP
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Error of loading a file: the file could not be read, or its content
+ * could not be parsed (input offset and error, as Schema::load positions it)
+ *
+ */
+using load_error = std::variant<FileAndArgsErrorsT, std::pair<std::size_t, ParsingErrorsT>>;
+
+/**
+ * @brief Owning handle on a file content, as one contiguous char range
+ *
+ * Regular files are mapped read-only, pipes and special files (or platforms
+ * without mmap) are read into an owned buffer. Subranges taken from the
+ * handle point straight into the mapping and live as long as the handle.
+ */
+class mapped_file;
+
+inline expected<mapped_file,FileAndArgsErrorsT> map_file(const std::string& filename);
+
+class mapped_file
+{
+public:
+    /**
+     * @brief Own an already read buffer
+     *
+     * @param buffer
+     */
+    explicit mapped_file(std::string buffer) : m_buffer(std::move(buffer))
+    {
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+    {
+        steal(other);
+    }
+
+    mapped_file& operator=(mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        release();
+    }
+
+    const char* data() const noexcept { return m_data; }
+    std::size_t size() const noexcept { return m_size; }
+    const char* begin() const noexcept { return m_data; }
+    const char* end() const noexcept { return m_data + m_size; }
+
+    /**
+     * @brief The whole content
+     *
+     * @return std::string_view
+     */
+    std::string_view view() const noexcept { return {m_data, m_size}; }
+
+    /**
+     * @brief true if the content is a memory mapping, false if it has been read in a buffer
+     *
+     */
+    bool is_mapped() const noexcept { return m_mapped; }
+
+private:
+    friend expected<mapped_file,FileAndArgsErrorsT> map_file(const std::string& filename);
+
+    /**
+     * @brief Adopt a read-only mapping of size bytes, unmapped on destruction:
+     * only map_file has such a mapping to give
+     *
+     * @param data
+     * @param size
+     */
+    mapped_file(const char* data, std::size_t size) : m_data(data), m_size(size), m_mapped(true) {}
+
+    void release() noexcept
+    {
+#ifdef CLINIARG_HAS_MMAP
+        if (m_mapped)
+            ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    void steal(mapped_file& other) noexcept
+    {
+        m_mapped = other.m_mapped;
+        m_size = other.m_size;
+        m_buffer = std::move(other.m_buffer);
+        m_data = m_mapped ? other.m_data : m_buffer.data(); // small buffers do not keep their address when moved
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_mapped = false;
+    }
+
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_mapped = false;
+    std::string m_buffer;
+};
+
+namespace detail
+{
+#ifdef CLINIARG_HAS_MMAP
+    /**
+     * @brief Read the remaining content of a file descriptor to a string
+     *
+     * @param fd
+     * @param out
+     * @return true all has been read
+     * @return false an io error occured
+     */
+    inline bool read_fd(int fd, std::string& out)
+    {
+        char block[1 << 16];
+        for (;;)
+        {
+            const ssize_t n = ::read(fd, block, sizeof(block));
+            if (n > 0)
+                out.append(block, n);
+            else if (n == 0)
+                return true;
+            else if (errno != EINTR)
+                return false;
+        }
+    }
+#endif
+} // namespace detail
+
+/**
+ * @brief Map a file read-only, falling back to reading it for pipes and special files
+ *
+ * @param filename
+ * @return expected<mapped_file,FileAndArgsErrorsT>
+ */
+inline expected<mapped_file,FileAndArgsErrorsT> map_file(const std::string& filename)
+{
+    const ::detail::stage_timer timer(parse_stage::read);
+#ifdef CLINIARG_HAS_MMAP
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return expected<mapped_file,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::filenotopened);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return expected<mapped_file,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::fileioerror);
+    }
+
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            ::close(fd);
+            ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            ::detail::count_bytes_read(st.st_size);
+            mapped_file mapping(static_cast<const char*>(addr), static_cast<std::size_t>(st.st_size));
+            return expected<mapped_file,FileAndArgsErrorsT>::success(std::move(mapping));
+        }
+    }
+
+    // Pipes, character devices, empty or unmappable files
+    std::string buffer;
+    const bool read = ::detail::read_fd(fd, buffer);
+    ::close(fd);
+    if (!read)
+        return expected<mapped_file,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::fileioerror);
+    ::detail::count_bytes_read(buffer.size());
+    ::detail::count_allocation();
+    return expected<mapped_file,FileAndArgsErrorsT>::success(std::move(buffer));
+#else
+    std::ifstream file_str(filename, std::ios::binary);
+    if (!file_str)
+        return expected<mapped_file,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::filenotopened);
+    std::string buffer;
+    ::detail::read_stream(file_str, buffer);
+    if (file_str.bad())
+        return expected<mapped_file,FileAndArgsErrorsT>::error(FileAndArgsErrorsT::fileioerror);
+    ::detail::count_bytes_read(buffer.size());
+    ::detail::count_allocation();
+    return expected<mapped_file,FileAndArgsErrorsT>::success(std::move(buffer));
+#endif
+}
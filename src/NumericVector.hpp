@@ -0,0 +1,132 @@
+/**
+ * @file NumericVector.hpp
+ * @brief Bulk parsing of long comma separated numeric values
+ *
+ * The elements are found with the vectorized scanner, counted first so that
+ * the output is allocated once, then converted with std::from_chars straight
+ * into it. Very long values can be cut in chunks parsed on several threads.
+ */
+#pragma once
+#include <algorithm>
+#include <future>
+#include <string_view>
+#include <vector>
+
+#include "CliniParser.hpp"
+#include "Scanner.hpp"
+
+namespace detail
+{
+    /**
+     * @brief Cut str in at most chunks chunks of about the same size, each boundary on a comma
+     *
+     * @param str
+     * @param chunks
+     * @return std::vector<std::size_t> chunk boundaries, from 0 to str.size()
+     */
+    inline std::vector<std::size_t> comma_chunks(std::string_view str, std::size_t chunks)
+    {
+        std::vector<std::size_t> bounds{0};
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            const std::size_t bound = str.find(',', std::max(bounds.back(), str.size() / chunks * i));
+            if (bound == std::string_view::npos)
+                break;
+            if (bound > bounds.back())
+                bounds.push_back(bound);
+        }
+        bounds.push_back(str.size());
+        return bounds;
+    }
+
+    /**
+     * @brief Number of non-empty elements of str
+     *
+     */
+    inline std::size_t count_elements(std::string_view str)
+    {
+        std::size_t n = 0;
+        for_each_token<scan_class::comma>(str, [&n](std::size_t, std::size_t, bool) { ++n; });
+        return n;
+    }
+
+    /**
+     * @brief Parse the non-empty elements of str into out
+     *
+     * @return true every element has been parsed
+     */
+    template <class ValueT>
+    bool parse_elements(std::string_view str, ValueT* out)
+    {
+        bool valid = true;
+        for_each_token<scan_class::comma>(str, [&](std::size_t first, std::size_t last, bool) {
+            if (!valid)
+                return;
+            const auto& res = from_chars_parse<ValueT>(str.data() + first, str.data() + last);
+            if (res)
+                *out++ = res.get();
+            else
+                valid = false;
+        });
+        return valid;
+    }
+} // namespace detail
+
+/**
+ * @brief vector_parse for arithmetic types, same result with a bulk path
+ *
+ * Elements follow the simple_parse rules: leading spaces and an explicit '+'
+ * are skipped, trailing characters are an error, and so is a negative value
+ * for an unsigned type.
+ *
+ * @tparam ValueT arithmetic type handled by std::from_chars
+ * @param str
+ * @param threads maximum number of threads, the calling one included
+ * @param min_chunk_size minimum number of bytes per thread
+ * @return expected_vector<ValueT>
+ */
+template <::detail::from_chars_arithmetic ValueT>
+expected_vector<ValueT> numeric_vector_parse(std::string_view str, std::size_t threads = 1,
+                                             std::size_t min_chunk_size = std::size_t{1} << 20)
+{
+    return ::detail::instrument(parse_stage::parse_value, [&] {
+        const std::size_t chunks = std::clamp<std::size_t>(str.size() / std::max<std::size_t>(min_chunk_size, 1),
+                                                           1, std::max<std::size_t>(threads, 1));
+        if (chunks == 1)
+        {
+            std::vector<ValueT> res(::detail::count_elements(str));
+            ::detail::count_allocation();
+            if (res.empty())
+                return expected_vector<ValueT>::error(ParsingErrorsT::emptyvector);
+            if (!::detail::parse_elements(str, res.data()))
+                return expected_vector<ValueT>::error(ParsingErrorsT::vectorvaluenotparsed);
+            return expected_vector<ValueT>::success(std::move(res));
+        }
+
+        const auto bounds = ::detail::comma_chunks(str, chunks);
+        const auto chunk = [&](std::size_t c) { return str.substr(bounds[c], bounds[c + 1] - bounds[c]); };
+
+        // Count the elements of every chunk, to know where each one writes
+        std::vector<std::future<std::size_t>> counts;
+        for (std::size_t c = 1; c + 1 < bounds.size(); ++c)
+            counts.push_back(std::async(std::launch::async, ::detail::count_elements, chunk(c)));
+        std::vector<std::size_t> offsets{0, ::detail::count_elements(chunk(0))};
+        for (auto& count : counts)
+            offsets.push_back(offsets.back() + count.get());
+
+        std::vector<ValueT> res(offsets.back());
+        ::detail::count_allocation();
+        if (res.empty())
+            return expected_vector<ValueT>::error(ParsingErrorsT::emptyvector);
+
+        std::vector<std::future<bool>> parsed;
+        for (std::size_t c = 1; c + 1 < bounds.size(); ++c)
+            parsed.push_back(std::async(std::launch::async, ::detail::parse_elements<ValueT>, chunk(c), res.data() + offsets[c]));
+        bool valid = ::detail::parse_elements(chunk(0), res.data());
+        for (auto& p : parsed)
+            valid = p.get() && valid;
+        if (!valid)
+            return expected_vector<ValueT>::error(ParsingErrorsT::vectorvaluenotparsed);
+        return expected_vector<ValueT>::success(std::move(res));
+    });
+}
@@ -0,0 +1,137 @@
+/**
+ * @file ParallelParser.hpp
+ * @brief Multi-threaded loading of a large configuration into a schema
+ *
+ * The input is cut into chunks at line breaks, each chunk is split and parsed
+ * on its own thread into a chunk-local struct, then the chunks are merged in
+ * input order: the result (last occurrence of a key wins, first error in input
+ * order) is the one of a sequential schema<...>::load.
+ */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <future>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Scanner.hpp"
+#include "Schema.hpp"
+
+namespace detail
+{
+    /**
+     * @brief Fields parsed from one chunk, up to its first error
+     *
+     * @tparam Schema
+     */
+    template <class Schema>
+    struct parsed_chunk
+    {
+        typename Schema::properties_type props{};
+        std::array<bool, Schema::size> assigned{};
+        std::optional<std::pair<std::size_t, ParsingErrorsT>> error; // offset in the whole input
+    };
+
+    /**
+     * @brief Cut str in at most chunks chunks of about the same size, each boundary on a line break
+     *
+     * @param str
+     * @param chunks
+     * @return std::vector<std::size_t> chunk boundaries, from 0 to str.size()
+     */
+    inline std::vector<std::size_t> line_chunks(std::string_view str, std::size_t chunks)
+    {
+        std::vector<std::size_t> bounds{0};
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            const std::size_t bound = str.find_first_of("\r\n", std::max(bounds.back(), str.size() / chunks * i));
+            if (bound == std::string_view::npos)
+                break;
+            if (bound > bounds.back())
+                bounds.push_back(bound);
+        }
+        bounds.push_back(str.size());
+        return bounds;
+    }
+
+    /**
+     * @brief Split and parse the lines of str[first, last), stopping at the first error
+     *
+     * @tparam Schema
+     * @param str whole input
+     * @param first
+     * @param last
+     * @return parsed_chunk<Schema>
+     */
+    template <class Schema>
+    parsed_chunk<Schema> parse_chunk(std::string_view str, std::size_t first, std::size_t last)
+    {
+        parsed_chunk<Schema> chunk;
+        for_each_token<scan_class::line>(str.substr(first, last - first), [&](std::size_t line_first, std::size_t line_last, bool comment) {
+            if (comment || chunk.error)
+                return;
+            const std::string_view line = str.substr(first + line_first, line_last - line_first);
+            const auto& kv = split_keyvalue_pair(line);
+            if (!kv)
+            {
+                chunk.error.emplace(line.data() - str.data(), kv.error().second);
+                return;
+            }
+            const std::string_view key = to_string_view(kv.get().first);
+            const std::string_view value = to_string_view(kv.get().second);
+            const std::size_t index = Schema::keys.find(key);
+            const auto& res = Schema::assign_field(chunk.props, index, value);
+            if (res)
+                chunk.assigned[index] = true;
+            else
+                chunk.error.emplace((res.error() == ParsingErrorsT::keynotfound ? key.data() : value.data()) - str.data(),
+                                    res.error());
+        });
+        return chunk;
+    }
+} // namespace detail
+
+/**
+ * @brief Parse the lines of str into props on several threads, same result as
+ * Schema::load(props, split_lines(str).get())
+ *
+ * Inputs smaller than two chunks are parsed on the calling thread.
+ *
+ * @tparam Schema schema<...> of the properties
+ * @tparam Rng contiguous char range, which must outlive the returned error position
+ * @param props
+ * @param str
+ * @param threads maximum number of threads, the calling one included
+ * @param min_chunk_size minimum number of bytes per thread
+ * @return auto expected<void, ParsingErrorWithPositionT<Rng>> at the first error in input order,
+ * positioned at the line (keyvaluenotparsed), the key (keynotfound) or the value
+ */
+template <class Schema, contiguous_range Rng>
+auto parallel_load(typename Schema::properties_type& props, Rng&& str,
+                   std::size_t threads = std::thread::hardware_concurrency(),
+                   std::size_t min_chunk_size = std::size_t{1} << 20)
+{
+    using result_t = expected<void, ParsingErrorWithPositionT<Rng>>;
+    const std::string_view view = ::detail::to_string_view(str);
+    const std::size_t chunks = std::clamp<std::size_t>(view.size() / std::max<std::size_t>(min_chunk_size, 1),
+                                                       1, std::max<std::size_t>(threads, 1));
+    const auto bounds = ::detail::line_chunks(view, chunks);
+
+    std::vector<std::future<::detail::parsed_chunk<Schema>>> pending;
+    for (std::size_t c = 1; c + 1 < bounds.size(); ++c)
+        pending.push_back(std::async(std::launch::async, ::detail::parse_chunk<Schema>, view, bounds[c], bounds[c + 1]));
+
+    auto chunk = ::detail::parse_chunk<Schema>(view, bounds[0], bounds[1]);
+    for (std::size_t c = 0;; ++c)
+    {
+        Schema::merge(props, chunk.props, chunk.assigned);
+        if (chunk.error)
+            return result_t::error(begin(str) + chunk.error->first, chunk.error->second);
+        if (c == pending.size())
+            return result_t::success();
+        chunk = pending[c].get();
+    }
+}
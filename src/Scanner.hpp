@@ -0,0 +1,278 @@
+/**
+ * @file Scanner.hpp
+ * @brief Vectorized line and argument splitting, replacing the fileline_re and commandline_re tokenization
+ *
+ */
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "CliniParser.hpp"
+#include "Simd.hpp"
+
+/**
+ * @brief Kind of delimiter between tokens
+ *
+ */
+enum class scan_class
+{
+    line,  // '\r' and '\n', as fileline_re
+    space, // ' ', '\t', '\n', '\v', '\f' and '\r', as commandline_re
+    comma  // ',', as vector_re
+};
+
+namespace detail
+{
+    /**
+     * @brief One bit per byte of a 64 bytes block
+     *
+     */
+    struct block_masks
+    {
+        std::uint64_t delimiters;
+        std::uint64_t comments; // '#' or '%'
+    };
+
+    template <scan_class Class>
+    constexpr bool is_delimiter(char c)
+    {
+        if constexpr (Class == scan_class::line)
+            return c == '\n' || c == '\r';
+        else if constexpr (Class == scan_class::comma)
+            return c == ',';
+        else
+            return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+    }
+
+    template <scan_class Class>
+    struct scalar_masks
+    {
+        block_masks operator()(const char* p) const
+        {
+            block_masks m{0, 0};
+            for (int i = 0; i < 64; ++i)
+            {
+                m.delimiters |= std::uint64_t{is_delimiter<Class>(p[i])} << i;
+                m.comments |= std::uint64_t{p[i] == '#' || p[i] == '%'} << i;
+            }
+            return m;
+        }
+    };
+
+#ifdef CLINIARG_HAS_SSE2
+    template <scan_class Class>
+    struct sse2_masks
+    {
+        block_masks operator()(const char* p) const
+        {
+            block_masks m{0, 0};
+            for (int k = 0; k < 4; ++k)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+                __m128i d;
+                if constexpr (Class == scan_class::line)
+                    d = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+                else if constexpr (Class == scan_class::comma)
+                    d = _mm_cmpeq_epi8(v, _mm_set1_epi8(','));
+                else
+                    d = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                     _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1))));
+                const __m128i c = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('#')), _mm_cmpeq_epi8(v, _mm_set1_epi8('%')));
+                m.delimiters |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(d))} << (16 * k);
+                m.comments |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(c))} << (16 * k);
+            }
+            return m;
+        }
+    };
+#endif
+
+#ifdef CLINIARG_HAS_AVX2
+    template <scan_class Class>
+    struct avx2_masks
+    {
+        __attribute__((target("avx2"))) block_masks operator()(const char* p) const
+        {
+            block_masks m{0, 0};
+            for (int k = 0; k < 2; ++k)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+                __m256i d;
+                if constexpr (Class == scan_class::line)
+                    d = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+                else if constexpr (Class == scan_class::comma)
+                    d = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','));
+                else
+                    d = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                        _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), v)));
+                const __m256i c = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('#')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('%')));
+                m.delimiters |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(d))} << (32 * k);
+                m.comments |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(c))} << (32 * k);
+            }
+            return m;
+        }
+    };
+#endif
+
+    /**
+     * @brief Walk 64 bytes blocks, turning the delimiter masks into token boundaries
+     *
+     * A token starts on a non delimiter following a delimiter (or the start), and
+     * ends on a delimiter following a non delimiter (or the end). The last partial
+     * block is padded with delimiters.
+     *
+     * @tparam Masks block mask provider
+     * @param data
+     * @param size
+     * @param f called with (first offset, last offset, starts with a comment char) for each token
+     */
+    template <scan_class Class, class Masks, class F>
+    inline void scan_blocks(const char* data, std::size_t size, F& f)
+    {
+        const Masks masks{};
+        std::size_t token_first = 0;
+        bool comment = false;
+        std::uint64_t prev_delimiter = 1;
+        for (std::size_t base = 0; base < size; base += 64)
+        {
+            block_masks m;
+            if (size - base >= 64)
+                m = masks(data + base);
+            else
+            {
+                char tail[64];
+                std::memset(tail, Class == scan_class::line ? '\n' : Class == scan_class::comma ? ',' : ' ', sizeof(tail));
+                std::memcpy(tail, data + base, size - base);
+                m = masks(tail);
+            }
+            const std::uint64_t follows_delimiter = (m.delimiters << 1) | prev_delimiter;
+            const std::uint64_t starts = ~m.delimiters & follows_delimiter;
+            const std::uint64_t ends = m.delimiters & ~follows_delimiter;
+            prev_delimiter = m.delimiters >> 63;
+            for (std::uint64_t events = starts | ends; events; events &= events - 1)
+            {
+                const int i = std::countr_zero(events);
+                if ((starts >> i) & 1)
+                {
+                    token_first = base + i;
+                    comment = (m.comments >> i) & 1;
+                }
+                else
+                    f(token_first, base + i, comment);
+            }
+        }
+        if (!prev_delimiter)
+            f(token_first, size, comment);
+    }
+
+#ifdef CLINIARG_HAS_AVX2
+    template <scan_class Class, class F>
+    __attribute__((target("avx2"), flatten)) void scan_avx2(const char* data, std::size_t size, F& f)
+    {
+        scan_blocks<Class, avx2_masks<Class>>(data, size, f);
+    }
+#endif
+
+    template <scan_class Class, class F>
+    void scan(std::string_view str, F&& f, simd_level level)
+    {
+        switch (level)
+        {
+#ifdef CLINIARG_HAS_AVX2
+        case simd_level::avx2:
+            scan_avx2<Class>(str.data(), str.size(), f);
+            break;
+#endif
+#ifdef CLINIARG_HAS_SSE2
+        case simd_level::sse2:
+            scan_blocks<Class, sse2_masks<Class>>(str.data(), str.size(), f);
+            break;
+#endif
+        default:
+            scan_blocks<Class, scalar_masks<Class>>(str.data(), str.size(), f);
+        }
+    }
+} // namespace detail
+
+/**
+ * @brief Call f(first, last, comment) with the offsets of every token of str,
+ * comment telling if the token starts with '#' or '%'
+ *
+ * @tparam Class delimiters between tokens
+ * @param str
+ * @param f
+ * @param level instruction set, the best available by default
+ */
+template <scan_class Class, class F>
+void for_each_token(std::string_view str, F&& f, simd_level level = detected_simd_level())
+{
+    const ::detail::stage_timer timer(parse_stage::tokenize);
+    ::detail::count_bytes_scanned(str.size());
+    if constexpr (instrumentation_enabled && Class == scan_class::line)
+    {
+        std::size_t lines = 0;
+        ::detail::scan<Class>(str, [&](std::size_t token_first, std::size_t token_last, bool comment) {
+            ++lines;
+            f(token_first, token_last, comment);
+        }, level);
+        ::detail::count_lines(lines);
+    }
+    else
+        ::detail::scan<Class>(str, f, level);
+}
+
+/**
+ * @brief Split a contiguous char range into a vector of subranges, skipping comments,
+ * same result as split_token with fileline_re (scan_class::line) or commandline_re (scan_class::space)
+ *
+ * @tparam Class delimiters between tokens
+ * @tparam Rng contiguous char range
+ * @param str
+ * @param level instruction set, the best available by default
+ * @return auto
+ */
+template <scan_class Class, contiguous_range Rng>
+auto scan_tokens(Rng&& str, simd_level level = detected_simd_level())
+{
+    using token_t = subrange<iterator_t<Rng>>;
+    const iterator_t<Rng> first = begin(str);
+    const std::string_view view(data(str), distance(str));
+
+    std::vector<token_t> res;
+    for_each_token<Class>(view, [&](std::size_t token_first, std::size_t token_last, bool comment) {
+        if (!comment)
+            res.emplace_back(first + token_first, first + token_last);
+    }, level);
+    if (!res.empty())
+        return expected_args<std::vector<token_t>>::success(std::move(res));
+    else
+        return expected_args<std::vector<token_t>>::error(FileAndArgsErrorsT::empty);
+}
+
+/**
+ * @brief Vectorized split_token(str, fileline_re)
+ *
+ * @tparam Rng contiguous char range
+ * @param str
+ * @return auto
+ */
+template <contiguous_range Rng>
+auto split_lines(Rng&& str)
+{
+    return scan_tokens<scan_class::line>(std::forward<Rng>(str));
+}
+
+/**
+ * @brief Vectorized split_token(str, commandline_re)
+ *
+ * @tparam Rng contiguous char range
+ * @param str
+ * @return auto
+ */
+template <contiguous_range Rng>
+auto split_args(Rng&& str)
+{
+    return scan_tokens<scan_class::space>(std::forward<Rng>(str));
+}
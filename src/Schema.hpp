@@ -0,0 +1,403 @@
+/**
+ * @file Schema.hpp
+ * @brief Compile-time declaration of the keys of a Properties struct
+ *
+ * Each field is declared once, with its key name and member pointer:
+ *
+ *     using PropertiesSchema = schema<
+ *         field<"oneint", &Properties::oneint>,
+ *         field<"onevectflot", &Properties::onevecfloat>>;
+ *
+ * and the schema dispatches a key, normalized as trim_spaces_underscores_andlower
+ * and looked up in a compile-time perfect hash, to the typed parsing of its member
+ * (parse_as): std::vector<T> members go through vector_parse<T>, lazy_vector<T>
+ * members through lazy_vector_parse<T>, std::string members take the raw value
+ * and other members go through simple_parse.
+ */
+#pragma once
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CliniParser.hpp"
+#include "KeyIndex.hpp"
+#include "LazyVector.hpp"
+#include "NumericVector.hpp"
+
+/**
+ * @brief Compile-time string, usable as a template argument
+ *
+ * @tparam N size with the terminating zero
+ */
+template <std::size_t N>
+struct fixed_string
+{
+    char value[N];
+
+    constexpr fixed_string(const char (&str)[N])
+    {
+        std::copy_n(str, N, value);
+    }
+
+    constexpr std::string_view view() const
+    {
+        return {value, N - 1};
+    }
+};
+
+namespace detail
+{
+    template <class>
+    struct member_pointer_traits;
+
+    template <class ClassT, class MemberT>
+    struct member_pointer_traits<MemberT ClassT::*>
+    {
+        using class_type = ClassT;
+        using member_type = MemberT;
+    };
+
+    template <class>
+    struct is_vector : std::false_type {};
+
+    template <class ValueT, class AllocT>
+    struct is_vector<std::vector<ValueT, AllocT>> : std::true_type {};
+
+    template <class>
+    struct is_std_array : std::false_type {};
+
+    template <class ValueT, std::size_t N>
+    struct is_std_array<std::array<ValueT, N>> : std::true_type {};
+
+    template <class>
+    struct is_lazy_vector : std::false_type {};
+
+    template <class ValueT>
+    struct is_lazy_vector<lazy_vector<ValueT>> : std::true_type {};
+
+    /**
+     * @brief View on a contiguous char range
+     *
+     * @tparam Rng
+     * @param str
+     * @return std::string_view
+     */
+    template <contiguous_range Rng>
+    std::string_view to_string_view(Rng&& str)
+    {
+        return {data(str), static_cast<std::size_t>(distance(str))};
+    }
+} // namespace detail
+
+/**
+ * @brief Parse a value according to its type: std::vector<T> through vector_parse<T>
+ * (numeric_vector_parse<T> for arithmetic T), lazy_vector<T> through lazy_vector_parse<T>,
+ * std::string as the raw value and other types through simple_parse
+ *
+ * @tparam ValueT
+ * @tparam Rng char range
+ * @param value
+ * @return expected<ValueT, ParsingErrorsT>
+ */
+template <class ValueT, range Rng>
+expected<ValueT, ParsingErrorsT> parse_as(Rng&& value)
+{
+    if constexpr (::detail::is_vector<ValueT>::value)
+    {
+        using element_type = typename ValueT::value_type;
+        if constexpr (std::is_same_v<ValueT, std::vector<element_type>> && ::detail::from_chars_arithmetic<element_type>
+                      && contiguous_range<Rng> && std::is_same_v<std::remove_cv_t<range_value_t<Rng>>, char>)
+            return numeric_vector_parse<element_type>(::detail::to_string_view(value));
+        else
+            return vector_parse<element_type>(value);
+    }
+    else if constexpr (::detail::is_lazy_vector<ValueT>::value)
+    {
+        if constexpr (contiguous_range<Rng> && std::is_same_v<std::remove_cv_t<range_value_t<Rng>>, char>)
+            return lazy_vector_parse<typename ValueT::value_type>(::detail::to_string_view(value));
+        else
+            return lazy_vector_parse<typename ValueT::value_type>(std::string(begin(value), end(value)));
+    }
+    else if constexpr (std::is_same_v<ValueT, std::string>)
+        return expected<ValueT, ParsingErrorsT>::success(begin(value), end(value));
+    else
+        return simple_parse<ValueT>(value);
+}
+
+/**
+ * @brief Constant evaluation version of parse_as: arithmetic types through
+ * constant_parse, std::array<T, N> through constant_vector_parse and
+ * std::string_view as the raw value
+ *
+ * @tparam ValueT
+ * @param value
+ * @return constant_parsed<ValueT>
+ */
+template <class ValueT>
+constexpr constant_parsed<ValueT> constant_parse_as(std::string_view value)
+{
+    if constexpr (::detail::is_std_array<ValueT>::value)
+        return constant_vector_parse<typename ValueT::value_type, std::tuple_size_v<ValueT>>(value);
+    else if constexpr (std::is_same_v<ValueT, std::string_view>)
+        return constant_parsed<ValueT>::success(value);
+    else
+    {
+        static_assert(std::is_arithmetic_v<ValueT>,
+                      "constant loading handles arithmetic, std::array and std::string_view members");
+        return constant_parse<ValueT>(value);
+    }
+}
+
+/**
+ * @brief Bind a key name to a member of a Properties-like struct
+ *
+ * @tparam Name key name
+ * @tparam Member member pointer
+ */
+template <fixed_string Name, auto Member>
+struct field
+{
+    using class_type = typename ::detail::member_pointer_traits<decltype(Member)>::class_type;
+    using member_type = typename ::detail::member_pointer_traits<decltype(Member)>::member_type;
+
+    static constexpr std::string_view name = Name.view();
+    static constexpr auto member = Member;
+
+    /**
+     * @brief Parse value and assign it to the member
+     *
+     * @tparam Rng char range
+     * @param props
+     * @param value
+     * @return expected<void, ParsingErrorsT>
+     */
+    template <range Rng>
+    static expected<void, ParsingErrorsT> assign(class_type& props, Rng&& value)
+    {
+        if constexpr (std::is_same_v<member_type, std::string>)
+            (props.*Member).assign(begin(value), end(value));
+        else
+        {
+            auto res = parse_as<member_type>(value);
+            if (!res)
+                return expected<void, ParsingErrorsT>::error(res.error());
+            props.*Member = std::move(res).get();
+        }
+        return expected<void, ParsingErrorsT>::success();
+    }
+
+    /**
+     * @brief Constant evaluation version of assign, see constant_parse_as
+     *
+     * @param props
+     * @param value
+     * @return std::optional<ParsingErrorsT> the error, if any
+     */
+    static constexpr std::optional<ParsingErrorsT> constant_assign(class_type& props, std::string_view value)
+    {
+        const auto& res = constant_parse_as<member_type>(value);
+        if (!res)
+            return res.error;
+        props.*Member = res.value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Move the member of from into the member of to
+     *
+     * @param to
+     * @param from
+     */
+    static void take(class_type& to, class_type& from)
+    {
+        to.*Member = std::move(from.*Member);
+    }
+};
+
+/**
+ * @brief Set of fields of one Properties-like struct
+ *
+ * @tparam Fields field<...> declarations
+ */
+template <class... Fields>
+struct schema
+{
+    static_assert(sizeof...(Fields) > 0, "a schema needs at least one field");
+
+    using properties_type = typename std::tuple_element_t<0, std::tuple<Fields...>>::class_type;
+    static_assert((std::is_same_v<typename Fields::class_type, properties_type> && ...),
+                  "all the fields of a schema must belong to the same struct");
+
+    static constexpr std::size_t size = sizeof...(Fields);
+
+    /**
+     * @brief Perfect hash of the field names
+     *
+     */
+    static constexpr key_index<size> keys{std::array<std::string_view, size>{Fields::name...}};
+
+    /**
+     * @brief Parse value into the member of the field at index
+     *
+     * @tparam ValueRng char range
+     * @param props
+     * @param index field index, as returned by keys.find()
+     * @param value
+     * @return expected<void, ParsingErrorsT> keynotfound for an out of range index
+     */
+    template <range ValueRng>
+    static expected<void, ParsingErrorsT> assign_field(properties_type& props, std::size_t index, ValueRng&& value)
+    {
+        return assign_field(props, index, value, std::index_sequence_for<Fields...>{});
+    }
+
+    /**
+     * @brief Parse value into the member bound to key
+     *
+     * @tparam KeyRng contiguous char range
+     * @tparam ValueRng char range
+     * @param props
+     * @param key raw key
+     * @param value
+     * @return expected<void, ParsingErrorsT> keynotfound for an undeclared key
+     */
+    template <contiguous_range KeyRng, range ValueRng>
+    static expected<void, ParsingErrorsT> assign(properties_type& props, KeyRng&& key, ValueRng&& value)
+    {
+        const std::size_t index = keys.find(::detail::to_string_view(key));
+        if (index >= size)
+            ::detail::count_error(ParsingErrorsT::keynotfound);
+        return assign_field(props, index, value);
+    }
+
+    /**
+     * @brief Split and assign every line, as returned by split_token
+     *
+     * @tparam Lines range of char ranges
+     * @param props
+     * @param lines
+     * @return auto expected<void, ParsingErrorWithPositionT> stopping at the first error,
+     * positioned at the line (keyvaluenotparsed), the key (keynotfound) or the value
+     */
+    template <range Lines>
+    static auto load(properties_type& props, Lines&& lines)
+    {
+        using result_t = expected<void, ParsingErrorWithPositionT<range_value_t<Lines>>>;
+        for (auto&& line : lines)
+        {
+            const auto& kv = split_keyvalue_pair(line);
+            if (!kv)
+                return result_t::error(kv.error().first, kv.error().second);
+            const auto& res = assign(props, kv.get().first, kv.get().second);
+            if (!res)
+                return result_t::error(res.error() == ParsingErrorsT::keynotfound ? begin(kv.get().first) : begin(kv.get().second),
+                                       res.error());
+        }
+        return result_t::success();
+    }
+
+    /**
+     * @brief Constant evaluation version of load, on a whole text
+     *
+     * Lines are split as split_lines does: empty lines and lines starting with
+     * '#' or '%' are skipped.
+     *
+     * @param props
+     * @param text
+     * @return std::optional<std::pair<std::size_t, ParsingErrorsT>> the first error, positioned
+     * in text at the line (keyvaluenotparsed), the key (keynotfound) or the value
+     */
+    static constexpr std::optional<std::pair<std::size_t, ParsingErrorsT>> constant_load(properties_type& props, std::string_view text)
+    {
+        for (std::size_t first = 0; first < text.size();)
+        {
+            const std::size_t last = std::min(text.find_first_of("\r\n", first), text.size());
+            const std::string_view line = text.substr(first, last - first);
+            const std::size_t offset = first;
+            first = last + 1;
+            if (line.empty() || line.front() == '#' || line.front() == '%')
+                continue;
+
+            const auto& kv = constant_split_keyvalue_pair(line);
+            if (!kv)
+                return std::pair{offset, kv.error};
+            const auto& [key, value] = kv.value;
+            const std::size_t index = keys.find(key);
+            if (index == size)
+                return std::pair{offset, ParsingErrorsT::keynotfound};
+            if (const auto& error = constant_assign_field(props, index, value, std::index_sequence_for<Fields...>{}))
+                return std::pair{offset + key.size() + 1, *error};
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Move the members of the assigned fields of from into to
+     *
+     * @param to
+     * @param from
+     * @param assigned per field index, as returned by keys.find()
+     */
+    static void merge(properties_type& to, properties_type& from, const std::array<bool, size>& assigned)
+    {
+        merge(to, from, assigned, std::index_sequence_for<Fields...>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static void merge(properties_type& to, properties_type& from, const std::array<bool, size>& assigned, std::index_sequence<I...>)
+    {
+        ((assigned[I] ? Fields::take(to, from) : void()), ...);
+    }
+
+    template <std::size_t... I>
+    static constexpr std::optional<ParsingErrorsT> constant_assign_field(properties_type& props, std::size_t index, std::string_view value, std::index_sequence<I...>)
+    {
+        std::optional<ParsingErrorsT> res;
+        (void)((I == index && (res = Fields::constant_assign(props, value), true)) || ...);
+        return res;
+    }
+
+    template <range ValueRng, std::size_t... I>
+    static expected<void, ParsingErrorsT> assign_field(properties_type& props, std::size_t index, ValueRng& value, std::index_sequence<I...>)
+    {
+        auto res = expected<void, ParsingErrorsT>::error(ParsingErrorsT::keynotfound);
+        (void)((I == index && (res = Fields::assign(props, value), true)) || ...);
+        return res;
+    }
+};
+
+namespace detail
+{
+    /**
+     * @brief Not constexpr: reaching it during a constant evaluation is a compile error
+     *
+     */
+    inline void configuration_literal_does_not_parse(std::size_t /*offset*/, ParsingErrorsT /*error*/) {}
+} // namespace detail
+
+/**
+ * @brief Properties loaded from an INI literal at compile time
+ *
+ *     constexpr auto defaults = constant_properties<DefaultsSchema, "threads=4\nratio=0.5">();
+ *
+ * A literal that does not parse fails to compile, in configuration_literal_does_not_parse.
+ *
+ * @tparam Schema schema<...> of a literal type with arithmetic, std::array and std::string_view members
+ * @tparam Text INI text, without sections
+ * @param props values of the keys absent from Text
+ * @return Schema::properties_type
+ */
+template <class Schema, fixed_string Text>
+consteval typename Schema::properties_type constant_properties(typename Schema::properties_type props = {})
+{
+    if (const auto& error = Schema::constant_load(props, Text.view()))
+        ::detail::configuration_literal_does_not_parse(error->first, error->second);
+    return props;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file Simd.hpp
+ * @brief Instruction set detection for the vectorized functions
+ *
+ */
+#pragma once
+
+// 32-bit x86 only when the compiler targets SSE2 (-msse2, /arch:SSE2)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLINIARG_HAS_SSE2
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define CLINIARG_HAS_AVX2
+#endif
+#endif
+
+/**
+ * @brief Instruction set used by the vectorized functions
+ *
+ */
+enum class simd_level
+{
+    scalar,
+    sse2,
+    avx2
+};
+
+/**
+ * @brief Best instruction set supported by the running CPU
+ *
+ * @return simd_level
+ */
+inline simd_level detected_simd_level()
+{
+    static const simd_level level = [] {
+#if defined(CLINIARG_HAS_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return simd_level::avx2;
+#endif
+#if defined(CLINIARG_HAS_SSE2)
+        return simd_level::sse2;
+#else
+        return simd_level::scalar;
+#endif
+    }();
+    return level;
+}
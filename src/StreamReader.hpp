@@ -0,0 +1,249 @@
+/**
+ * @file StreamReader.hpp
+ * @brief Bounded memory, chunked reading of key/value lines
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "CliniParser.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#define CLINIARG_HAS_FD_READ
+#endif
+
+/**
+ * @brief Split a std::istream, a file descriptor or a file in lines, with a fixed-size buffer
+ *
+ * Lines follow fileline_re (maximal runs without '\r' or '\n'). A line straddling
+ * two chunks is moved to the front of the buffer before reading the next chunk,
+ * the buffer only grows when a single line does not fit in it: memory stays
+ * bounded by max(chunk size, longest line) whatever the input size.
+ */
+class line_reader
+{
+public:
+    static constexpr std::size_t default_chunk_size = 1 << 16;
+
+    /**
+     * @brief Read from a stream, which must outlive the reader
+     *
+     * @param in
+     * @param chunk_size
+     */
+    explicit line_reader(std::istream& in, std::size_t chunk_size = default_chunk_size)
+        : m_stream(&in), m_buffer(std::max<std::size_t>(chunk_size, 1)) {}
+
+#ifdef CLINIARG_HAS_FD_READ
+    /**
+     * @brief Read from a file descriptor (file, pipe, socket...), not closed by the reader
+     *
+     * @param fd
+     * @param chunk_size
+     */
+    explicit line_reader(int fd, std::size_t chunk_size = default_chunk_size)
+        : m_fd(fd), m_buffer(std::max<std::size_t>(chunk_size, 1)) {}
+#endif
+
+    /**
+     * @brief Read from a file
+     *
+     * @param filename
+     * @param chunk_size
+     */
+    explicit line_reader(const std::string& filename, std::size_t chunk_size = default_chunk_size)
+        : m_file(std::make_unique<std::ifstream>(filename, std::ios::binary)), m_buffer(std::max<std::size_t>(chunk_size, 1))
+    {
+        m_stream = m_file.get();
+        if (!*m_file)
+            m_error = FileAndArgsErrorsT::filenotopened;
+    }
+
+    /**
+     * @brief Next non-empty line, valid until the next call
+     *
+     * @return std::optional<std::string_view> std::nullopt at end of input or on error
+     */
+    std::optional<std::string_view> next_line()
+    {
+        for (;;)
+        {
+            while (m_pos < m_end && is_eol(m_buffer[m_pos]))
+                ++m_pos;
+            m_scanned = std::max(m_scanned, m_pos);
+
+            const auto eol = std::find_if(m_buffer.data() + m_scanned, m_buffer.data() + m_end, is_eol);
+            m_scanned = eol - m_buffer.data();
+            if (m_scanned < m_end || (m_eof && m_pos < m_end))
+            {
+                const std::string_view line(m_buffer.data() + m_pos, m_scanned - m_pos);
+                m_line_offset = m_offset + m_pos;
+                m_pos = m_scanned;
+                return line;
+            }
+            if (m_eof || m_error)
+                return std::nullopt;
+            fill();
+        }
+    }
+
+    /**
+     * @brief Byte offset in the input of the last line returned
+     *
+     * @return std::size_t
+     */
+    std::size_t line_offset() const noexcept { return m_line_offset; }
+
+    /**
+     * @brief Current buffer size, the chunk size unless a longer line has been met
+     *
+     * @return std::size_t
+     */
+    std::size_t buffer_size() const noexcept { return m_buffer.size(); }
+
+    /**
+     * @brief Reading error, if any
+     *
+     * @return const std::optional<FileAndArgsErrorsT>&
+     */
+    const std::optional<FileAndArgsErrorsT>& error() const noexcept { return m_error; }
+
+private:
+    static bool is_eol(char c) { return c == '\n' || c == '\r'; }
+
+    /**
+     * @brief Move the pending partial line to the front and read the next chunk after it
+     *
+     */
+    void fill()
+    {
+        if (m_pos > 0)
+        {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_pos, m_end - m_pos);
+            m_offset += m_pos;
+            m_end -= m_pos;
+            m_scanned -= m_pos;
+            m_pos = 0;
+        }
+        if (m_end == m_buffer.size()) // a single line fills the buffer
+            m_buffer.resize(m_buffer.size() * 2);
+
+        const std::size_t capacity = m_buffer.size() - m_end;
+        std::size_t read = 0;
+        if (m_stream)
+        {
+            m_stream->read(m_buffer.data() + m_end, capacity);
+            read = m_stream->gcount();
+            if (m_stream->bad())
+                m_error = FileAndArgsErrorsT::fileioerror;
+        }
+#ifdef CLINIARG_HAS_FD_READ
+        else
+        {
+            ssize_t n;
+            while ((n = ::read(m_fd, m_buffer.data() + m_end, capacity)) < 0 && errno == EINTR)
+                ;
+            if (n < 0)
+                m_error = FileAndArgsErrorsT::fileioerror;
+            else
+                read = n;
+        }
+#endif
+        m_end += read;
+        m_eof = read == 0;
+    }
+
+    std::unique_ptr<std::ifstream> m_file;
+    std::istream* m_stream = nullptr;
+    int m_fd = -1;
+    std::vector<char> m_buffer;
+    std::size_t m_pos = 0;      // start of the unread data
+    std::size_t m_scanned = 0;  // end of the data known to hold no line break
+    std::size_t m_end = 0;      // end of the data in the buffer
+    std::size_t m_offset = 0;   // input offset of the buffer start
+    std::size_t m_line_offset = 0;
+    bool m_eof = false;
+    std::optional<FileAndArgsErrorsT> m_error;
+};
+
+/**
+ * @brief Key/value record of a stream, the views are valid until the next read
+ *
+ */
+struct stream_record
+{
+    std::string_view key;
+    std::string_view value;
+    std::size_t offset; // input offset of the line
+};
+
+/**
+ * @brief Expected stream record, the error holds the input offset of the line
+ *
+ */
+using expected_stream_record = expected<stream_record, std::pair<std::size_t, ParsingErrorsT>>;
+
+/**
+ * @brief Yield the key/value records of a stream with a bounded buffer,
+ * skipping the '#' or '%' comments as split_token does
+ *
+ */
+class ini_stream_reader
+{
+public:
+    /**
+     * @brief Build the underlying line_reader from a stream, a file descriptor or a filename and a chunk size
+     *
+     */
+    template <class... Source>
+        requires std::constructible_from<line_reader, Source...>
+    explicit ini_stream_reader(Source&&... source) : m_lines(std::forward<Source>(source)...) {}
+
+    /**
+     * @brief Next record
+     *
+     * @return std::optional<expected_stream_record> std::nullopt at end of input or on reading error
+     */
+    std::optional<expected_stream_record> next()
+    {
+        while (const auto line = m_lines.next_line())
+        {
+            if ((*line)[0] == '#' || (*line)[0] == '%')
+                continue;
+            const auto& kv = split_keyvalue_pair(*line);
+            if (kv)
+                return expected_stream_record::success(stream_record{
+                    std::string_view(kv.get().first.begin(), kv.get().first.end()),
+                    std::string_view(kv.get().second.begin(), kv.get().second.end()),
+                    m_lines.line_offset()});
+            else
+                return expected_stream_record::error(m_lines.line_offset(), kv.error().second);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Reading error, if any
+     *
+     * @return const std::optional<FileAndArgsErrorsT>&
+     */
+    const std::optional<FileAndArgsErrorsT>& error() const noexcept { return m_lines.error(); }
+
+    /**
+     * @brief Underlying line reader
+     *
+     * @return const line_reader&
+     */
+    const line_reader& lines() const noexcept { return m_lines; }
+
+private:
+    line_reader m_lines;
+};
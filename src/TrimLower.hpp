@@ -1,14 +1,38 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <locale>
 #include <range/v3/all.hpp>
 
+#include "Simd.hpp"
+
 using namespace ranges;
 
 namespace detail
 {
+    /**
+     * @brief Classification and lowercase of the 256 char values, as in the "C" locale
+     *
+     */
+    struct ascii_table
+    {
+        std::array<bool, 256> trim;   // space or "_"
+        std::array<char, 256> lower;
+    };
+
+    inline constexpr ascii_table ascii = [] {
+        ascii_table table{};
+        for (int c = 0; c < 256; ++c)
+        {
+            table.trim[c] = c == ' ' || (c >= '\t' && c <= '\r') || c == '_';
+            table.lower[c] = static_cast<char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+        }
+        return table;
+    }();
+
     /**
      * @brief Return true if space or "_"
      *
@@ -16,45 +40,168 @@ namespace detail
      * @return true
      * @return false
      */
-    bool to_trim(char c)
+    constexpr bool to_trim(char c)
+    {
+        return ascii.trim[static_cast<unsigned char>(c)];
+    }
+
+    /**
+     * @brief Return true if space in loc or "_"
+     *
+     * @param c
+     * @param loc
+     * @return true
+     * @return false
+     */
+    inline bool to_trim(char c, const std::locale& loc)
+    {
+        return std::isspace(c, loc) || (c == '_');
+    }
+
+    /**
+     * @brief ASCII lowercase
+     *
+     * @param c
+     * @return char
+     */
+    constexpr char to_lower(char c)
+    {
+        return ascii.lower[static_cast<unsigned char>(c)];
+    }
+
+    /**
+     * @brief Remove the trimmed chars and lower the others in place, in one pass
+     *
+     * Blocks of 16 chars without any space or underscore are copied and lowered with SSE2.
+     *
+     * @param s
+     * @param lower false to only trim
+     */
+    inline void trim_lower_inplace(std::string& s, bool lower)
     {
-        return std::isspace(c, std::locale()) || (c == '_');
+        char* out = s.data();
+        const char* in = s.data();
+        const char* const last = s.data() + s.size();
+#ifdef CLINIARG_HAS_SSE2
+        const __m128i underscore = _mm_set1_epi8('_');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab_m1 = _mm_set1_epi8('\t' - 1);
+        const __m128i cr_p1 = _mm_set1_epi8('\r' + 1);
+        const __m128i a_m1 = _mm_set1_epi8('A' - 1);
+        const __m128i z_p1 = _mm_set1_epi8('Z' + 1);
+        const __m128i case_bit = _mm_set1_epi8(lower ? 0x20 : 0);
+        while (last - in >= 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i trim = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, underscore), _mm_cmpeq_epi8(v, space)),
+                                              _mm_and_si128(_mm_cmpgt_epi8(v, tab_m1), _mm_cmplt_epi8(v, cr_p1)));
+            if (_mm_movemask_epi8(trim) == 0)
+            {
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, a_m1), _mm_cmplt_epi8(v, z_p1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_or_si128(v, _mm_and_si128(upper, case_bit)));
+                in += 16;
+                out += 16;
+            }
+            else
+                for (const char* block_last = in + 16; in != block_last; ++in)
+                    if (!to_trim(*in))
+                        *out++ = lower ? to_lower(*in) : *in;
+        }
+#endif
+        for (; in != last; ++in)
+            if (!to_trim(*in))
+                *out++ = lower ? to_lower(*in) : *in;
+        s.resize(out - s.data());
     }
 } // namespace detail
 
 /**
  * @brief removes spaces and underscores from a string
- * 
- * @param s 
- * @return std::string 
+ *
+ * @param s
+ * @return std::string
+ */
+inline std::string trim_spaces_underscores(std::string s)
+{
+    ::detail::trim_lower_inplace(s, false);
+    return s;
+}
+
+/**
+ * @brief removes spaces (of a given locale) and underscores from a string
+ *
+ * @param s
+ * @param loc
+ * @return std::string
  */
-std::string trim_spaces_underscores(std::string s)
+inline std::string trim_spaces_underscores(std::string s, const std::locale& loc)
 {
-    s |= actions::remove_if(::detail::to_trim);
+    s |= actions::remove_if([&loc](char c) { return ::detail::to_trim(c, loc); });
     return s;
 }
 
 /**
  * @brief lower all char in a string
- * 
- * @param s 
- * @return std::string 
+ *
+ * @param s
+ * @return std::string
  */
-std::string str_tolower(std::string s)
+inline std::string str_tolower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), ::detail::to_lower);
+    return s;
+}
+
+/**
+ * @brief lower all char in a string, with a given locale
+ *
+ * @param s
+ * @param loc
+ * @return std::string
+ */
+inline std::string str_tolower(std::string s, const std::locale& loc)
 {
     // https://en.cppreference.com/w/cpp/string/byte/tolower
-    s |= actions::transform([](auto c)
-                            { return std::tolower(c, std::locale()); });
+    s |= actions::transform([&loc](auto c)
+                            { return std::tolower(c, loc); });
+    return s;
+}
+
+/**
+ * @brief compose two previous functions, in a single pass over s
+ *
+ * @param s
+ * @return std::string
+ */
+inline std::string trim_spaces_underscores_andlower(std::string s)
+{
+    ::detail::trim_lower_inplace(s, true);
     return s;
 }
 
 /**
- * @brief compose two previous functions
- * 
- * @param s 
- * @return std::string 
+ * @brief compose two previous functions, with a given locale
+ *
+ * @param s
+ * @param loc
+ * @return std::string
  */
-std::string trim_spaces_underscores_andlower(std::string s)
+inline std::string trim_spaces_underscores_andlower(std::string s, const std::locale& loc)
 {
-    return str_tolower(trim_spaces_underscores(s));
-}
\ No newline at end of file
+    return str_tolower(trim_spaces_underscores(std::move(s), loc), loc);
+}
+
+/**
+ * @brief Lazy trim_spaces_underscores_andlower, as a view on a char range
+ *
+ * @tparam Rng
+ * @param s
+ * @return auto
+ */
+template <range Rng>
+auto normalized_view(Rng&& s)
+{
+    return std::forward<Rng>(s)
+        | views::remove_if([](char c) { return ::detail::to_trim(c); })
+        | views::transform(::detail::to_lower);
+}
@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Arguments.hpp"
+#include "LayeredConfig.hpp"
+#include "./Settings.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Arguments reading" ) {
+    const char* argv[] = {"program", "truc=machin", "bidule=2", "", "# skipped", "blah=4,5,6", "phrase=with some spaces", nullptr};
+    const int argc = 7;
+    const auto args = arguments(argc, argv);
+    REQUIRE( args.size() == 6 );
+
+    const auto& vecres_rng = split_arguments(args);
+    REQUIRE( vecres_rng.is_valid() );
+    const auto& vecres = vecres_rng.get();
+    REQUIRE( vecres == std::vector<std::string_view>{"truc=machin"sv, "bidule=2"sv, "blah=4,5,6"sv, "phrase=with some spaces"sv} );
+    REQUIRE( vecres[0].data() == argv[1] ); // in place
+
+    std::vector<std::pair<std::string_view, std::string_view>> pairs;
+    REQUIRE( for_each_argument(args, [&](std::string_view key, std::string_view value) { pairs.emplace_back(key, value); }).is_valid() );
+    REQUIRE( pairs.size() == 4 );
+    REQUIRE( pairs[3] == std::pair{"phrase"sv, "with some spaces"sv} );
+    REQUIRE( pairs[2].second.data() == argv[5] + 5 );
+    REQUIRE( vector_parse<size_t>(pairs[2].second).get() == std::vector<size_t>{4,5,6} );
+
+    // same split as the joined command line
+    const std::string cmd_str{R"#(truc=machin bidule=2 blah=4,5,6)#"};
+    const auto joined = split_token(cmd_str, commandline_re).get();
+    const auto direct = split_arguments(args.first(5)).get();
+    REQUIRE( joined.size() == direct.size() );
+    for (size_t i = 0; i < joined.size(); ++i)
+        REQUIRE( to<std::string>(joined[i]) == std::string(direct[i]) );
+
+    REQUIRE( arguments(1, argv).empty() );
+    REQUIRE( split_arguments(arguments(1, argv)).error() == FileAndArgsErrorsT::empty );
+}
+
+TEST_CASE( "Arguments into a schema" ) {
+    const char* argv[] = {"program", "oneint=3", "One_Vect_Flot=1.5,2", "onestring=a b c"};
+    Properties props{};
+    REQUIRE( load_arguments<PropertiesSchema>(props, arguments(4, argv)).is_valid() );
+    REQUIRE( props.oneint == 3 );
+    REQUIRE( props.onevecfloat == std::vector<float>{1.5f,2.0f} );
+    REQUIRE( props.onestring == "a b c"s );
+
+    const char* bad[] = {"oneint=3", "novalue=", "oneint=4"};
+    REQUIRE( load_arguments<PropertiesSchema>(props, bad).error() == std::pair<std::size_t, ParsingErrorsT>{1, ParsingErrorsT::keyvaluenotparsed} );
+    const char* unknown[] = {"oneint=5", "unknown=3"};
+    REQUIRE( load_arguments<PropertiesSchema>(props, unknown).error() == std::pair<std::size_t, ParsingErrorsT>{1, ParsingErrorsT::keynotfound} );
+    REQUIRE( props.oneint == 5 );
+
+    const auto& layer = config_layer::from_arguments(arguments(4, argv));
+    REQUIRE( layer.get().find("", "onestring") == "a b c"sv );
+    REQUIRE( layer.get().find("", "onestring")->data() == argv[3] + 10 ); // in place
+    REQUIRE( layer.get().size() == 3 );
+    REQUIRE( !layer.get().find("section", "oneint") );
+
+    // errors positioned at the argument, comments and empty arguments counted
+    const char* typo[] = {"oneint=3", "# comment", "", "oneint=x"};
+    layered_config config;
+    config.push(config_layer::from_arguments(typo).get());
+    REQUIRE( config.find("", "ONE_INT") == "x"sv );
+    const auto& res = config.load<PropertiesSchema>(props);
+    REQUIRE( res.error().offset == 3 );
+    REQUIRE( res.error().error == ParsingErrorsT::valuenotparsed );
+    const char* header[] = {"oneint=3", "[a]=1"};
+    REQUIRE( config_layer::from_arguments(header).error() == std::pair<std::size_t, ParsingErrorsT>{1, ParsingErrorsT::keyvaluenotparsed} );
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <variant>
+#include "BatchLoader.hpp"
+#include "./Settings.hpp"
+#include "./TestFiles.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Batch loading of many files" ) {
+    const auto dir = std::filesystem::temp_directory_path() / "cliniarg_test_batch";
+    std::filesystem::create_directories(dir);
+
+    std::vector<std::string> filenames;
+    for (int i = 0; i < 200; ++i)
+    {
+        const auto path = dir / ("run" + std::to_string(i) + ".ini");
+        write_text(path, "# run " + std::to_string(i) + "\noneint=" + std::to_string(i) + "\nonevectflot=1," + std::to_string(i) + "\n");
+        filenames.push_back(path.string());
+    }
+    filenames[17] = (dir / "missing.ini").string();
+    write_text(dir / "bad.ini", "oneint=1\nonevectflot=1,x\n");
+    filenames[42] = (dir / "bad.ini").string();
+
+    Properties defaults{};
+    defaults.onestring = "default"s;
+    for (std::size_t threads : {1, 4})
+        for (std::size_t block : {1, 8, 500})
+        {
+            const auto& res = batch_load<PropertiesSchema>(filenames, defaults, threads, block);
+            REQUIRE( res.size() == filenames.size() );
+            for (std::size_t i = 0; i < filenames.size(); ++i)
+            {
+                if (i == 17)
+                {
+                    REQUIRE( std::get<FileAndArgsErrorsT>(res[i].error()) == FileAndArgsErrorsT::filenotopened );
+                    continue;
+                }
+                if (i == 42)
+                {
+                    // positioned at the value, as Schema::load does
+                    REQUIRE( std::get<1>(res[i].error()) == std::pair{std::size_t{21}, ParsingErrorsT::vectorvaluenotparsed} );
+                    continue;
+                }
+                REQUIRE( res[i].is_valid() );
+                REQUIRE( res[i].get().oneint == i );
+                REQUIRE( res[i].get().onevecfloat == std::vector<float>{1, static_cast<float>(i)} );
+                REQUIRE( res[i].get().onestring == "default"s );
+            }
+        }
+
+    REQUIRE( batch_load<PropertiesSchema>(std::span<const std::string>{}).empty() );
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,32 @@
+#include <catch2/catch_test_macros.hpp>
+#include "CliniArg.hpp"
+#include "LazyConfig.hpp" // the whole header set, linked with the library: no ODR clash
+
+using namespace std::literals;
+
+TEST_CASE( "Compiled library interface" ) {
+    REQUIRE( parse_value<int>("-42"sv).get() == -42 );
+    REQUIRE( parse_value<size_t>("-42"s).error() == ParsingErrorsT::valuenotparsed );
+    REQUIRE( parse_value<double>("2.5"sv).get() == 2.5 );
+    REQUIRE( parse_value<bool>("1"sv).get() );
+    REQUIRE( parse_vector<float>("1,,2.5"sv).get() == std::vector<float>{1, 2.5f} );
+    REQUIRE( parse_vector<unsigned>("1,-2"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+
+    const auto& kv = split_keyvalue("One_Key = value"sv);
+    REQUIRE( kv.get().first == "One_Key "sv );
+    REQUIRE( normalize_key(std::string(kv.get().first)) == "onekey"s );
+    REQUIRE( split_keyvalue("novalue="sv).error() == ParsingErrorsT::keyvaluenotparsed );
+
+    const auto& file = read_file("test-file.ini");
+    const auto& lines = tokenize_lines(file.get());
+    REQUIRE( lines.get().size() == 3 );
+    REQUIRE( lines.get()[2] == "blah=4,5,6"sv );
+    REQUIRE( tokenize_args("a=1 \t b=2"sv).get() == std::vector{"a=1"sv, "b=2"sv} );
+    REQUIRE( tokenize_lines("# comment\n"sv).error() == FileAndArgsErrorsT::empty );
+    REQUIRE( read_file("nothing.ini").error() == FileAndArgsErrorsT::filenotopened );
+
+    // the header templates use the library instantiations
+    const std::string value{"7"};
+    REQUIRE( simple_parse<long>(value).get() == 7 );
+    REQUIRE( vector_parse<double>(std::string_view(value)).get() == std::vector<double>{7} );
+}
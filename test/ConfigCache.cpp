@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include "ConfigCache.hpp"
+#include "./Settings.hpp"
+#include "./TestFiles.hpp"
+
+using namespace std::literals;
+
+struct Pointing { int* p; };
+static_assert(::detail::is_cacheable<std::vector<float>>::value);
+static_assert(::detail::is_cacheable<std::array<int, 3>>::value);
+static_assert(!::detail::is_cacheable<int*>::value);
+static_assert(!::detail::is_cacheable<Pointing>::value);
+static_assert(!::detail::is_cacheable<std::vector<const char*>>::value);
+static_assert(!::detail::is_cacheable<std::array<int*, 2>>::value);
+
+TEST_CASE( "Cached loading" ) {
+    const auto path = std::filesystem::temp_directory_path() / "cliniarg_test_cache.ini";
+    const std::string cache = path.string() + ".cache";
+    std::filesystem::remove(cache);
+    write_text(path, "oneint=2\n# comment\nonevectflot=4,5,6\noneint=3\n");
+
+    Properties parsed{};
+    parsed.onestring = "default"s;
+    REQUIRE( cached_load<PropertiesSchema>(parsed, path.string()).get() == cache_status::written );
+    REQUIRE( std::filesystem::exists(cache) );
+
+    Properties cached{};
+    cached.onestring = "other default"s;
+    REQUIRE( cached_load<PropertiesSchema>(cached, path.string()).get() == cache_status::hit );
+    REQUIRE( cached.oneint == 3 );
+    REQUIRE( cached.onevecfloat == std::vector<float>{4,5,6} );
+    REQUIRE( cached.onestring == "other default"s ); // absent keys are not stored
+    REQUIRE( parsed.oneint == 3 );
+    REQUIRE( parsed.onevecfloat == cached.onevecfloat );
+
+    // same size and modification time, new content: caught by the content hash
+    const auto mtime = std::filesystem::last_write_time(path);
+    const auto size = std::filesystem::file_size(path);
+    write_text(path, "oneint=2\n# comment\nonevectflot=4,5,8\noneint=9\n");
+    std::filesystem::last_write_time(path, mtime);
+    REQUIRE( std::filesystem::file_size(path) == size );
+    REQUIRE( cached_load<PropertiesSchema>(cached, path.string()).get() == cache_status::written );
+    REQUIRE( cached.oneint == 9 );
+    REQUIRE( cached.onevecfloat == std::vector<float>{4,5,8} );
+    Properties rehit{};
+    REQUIRE( cached_load<PropertiesSchema>(rehit, path.string()).get() == cache_status::hit );
+    REQUIRE( rehit.oneint == 9 );
+
+    // new size
+    write_text(path, "oneint=7\n# comment\nonevectflot=4,5,8\noneint=3\nonestring=truc");
+    REQUIRE( cached_load<PropertiesSchema>(cached, path.string()).get() == cache_status::written );
+    REQUIRE( cached_load<PropertiesSchema>(cached, path.string()).get() == cache_status::hit );
+    REQUIRE( cached.onevecfloat == std::vector<float>{4,5,8} );
+    REQUIRE( cached.onestring == "truc"s );
+
+    // truncated image
+    std::filesystem::resize_file(cache, std::filesystem::file_size(cache) - 3);
+    Properties reparsed{};
+    REQUIRE( cached_load<PropertiesSchema>(reparsed, path.string()).get() == cache_status::written );
+    REQUIRE( reparsed.onestring == "truc"s );
+
+    std::filesystem::remove(cache);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE( "Cached loading errors" ) {
+    const auto path = std::filesystem::temp_directory_path() / "cliniarg_test_cache_errors.ini";
+    const std::string cache = path.string() + ".cache";
+    std::filesystem::remove(cache);
+
+    Properties props{};
+    REQUIRE( std::get<FileAndArgsErrorsT>(cached_load<PropertiesSchema>(props, "no-such-file.ini").error()) == FileAndArgsErrorsT::filenotopened );
+
+    write_text(path, "oneint=2\nunknown=5\n");
+    const auto& res = cached_load<PropertiesSchema>(props, path.string());
+    REQUIRE( std::get<1>(res.error()) == std::pair<std::size_t, ParsingErrorsT>{9, ParsingErrorsT::keynotfound} );
+    REQUIRE( props.oneint == 2 );
+    REQUIRE( !std::filesystem::exists(cache) );
+
+    write_text(path, "");
+    REQUIRE( cached_load<PropertiesSchema>(props, path.string(), cache).get() == cache_status::written );
+    REQUIRE( cached_load<PropertiesSchema>(props, path.string(), cache).get() == cache_status::hit );
+    REQUIRE( props.oneint == 2 );
+
+    std::filesystem::remove(cache);
+    std::filesystem::remove(path);
+}
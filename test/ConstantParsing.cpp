@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Schema.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+using namespace std::literals;
+
+static_assert(constant_parse<int>("-42").value == -42);
+static_assert(constant_parse<unsigned>(" +7").value == 7u);
+static_assert(constant_parse<unsigned>("-0").valid);
+static_assert(!constant_parse<unsigned>("-1").valid);
+static_assert(!constant_parse<int>("3.5").valid);
+static_assert(!constant_parse<int>("2147483648").valid);
+static_assert(constant_parse<int>("-2147483648").value == -2147483647 - 1);
+static_assert(constant_parse<double>("2.5e-3").value == 2.5e-3);
+static_assert(constant_parse<float>(".5").value == 0.5f);
+static_assert(constant_parse<float>("3.824666887521744e-01").value == 0x1.87a55ap-2f); // not through double
+static_assert(constant_parse<float>("2.178530115634203e-02").value == 0x1.64ee2ep-6f);
+static_assert(constant_parse<float>("3.4028235e38").value == std::numeric_limits<float>::max());
+static_assert(!constant_parse<float>("3.4028236e38").valid);
+static_assert(constant_parse<float>("7e-46").value == 0 && constant_parse<float>("8e-46").value == std::numeric_limits<float>::denorm_min());
+static_assert(constant_parse<double>("-1e-400").value == 0 && std::signbit(constant_parse<double>("-1e-400").value));
+static_assert(constant_parse<double>("2e-324").valid && !constant_parse<double>("1.8e308").valid);
+static_assert(!constant_parse<double>("1e").valid);
+static_assert(!constant_parse<double>("1e400").valid);
+static_assert(!constant_parse<double>("inf").valid);
+static_assert(constant_parse<bool>("1").value && !constant_parse<bool>("2").valid);
+static_assert(constant_vector_parse<int, 3>("1,,2,3,").value == std::array<int, 3>{1, 2, 3});
+static_assert(constant_vector_parse<int, 3>(",").error == ParsingErrorsT::emptyvector);
+static_assert(constant_vector_parse<int, 3>("1,2").error == ParsingErrorsT::vectorvaluenotparsed);
+static_assert(constant_split_keyvalue_pair("a=b=c").value.second == "b=c");
+static_assert(!constant_split_keyvalue_pair("=b").valid);
+
+struct Defaults
+{
+    int threads;
+    double ratio;
+    std::array<float, 3> weights;
+    std::string_view name;
+    bool verbose;
+};
+
+using DefaultsSchema = schema<
+    field<"threads", &Defaults::threads>,
+    field<"ratio", &Defaults::ratio>,
+    field<"weights", &Defaults::weights>,
+    field<"name", &Defaults::name>,
+    field<"verbose", &Defaults::verbose>>;
+
+constexpr auto defaults = constant_properties<DefaultsSchema,
+    "# compiled in defaults\n"
+    "threads = 4\n"
+    "Ratio=0.25\r\n"
+    "weights=1,0.5,0.25\n"
+    "name=default run\n">(Defaults{1, 0, {}, "unset", true});
+
+static_assert(defaults.threads == 4);
+static_assert(defaults.ratio == 0.25);
+static_assert(defaults.weights == std::array<float, 3>{1, 0.5f, 0.25f});
+static_assert(defaults.name == "default run");
+static_assert(defaults.verbose);
+
+constexpr auto load_error(std::string_view text)
+{
+    Defaults props{};
+    return DefaultsSchema::constant_load(props, text);
+}
+
+static_assert(!load_error("threads=2\nverbose=0"));
+static_assert(*load_error("threads=2\nnothing") == std::pair{10ul, ParsingErrorsT::keyvaluenotparsed});
+static_assert(*load_error("threads=2\nunknown=1") == std::pair{10ul, ParsingErrorsT::keynotfound});
+static_assert(*load_error("threads=2\nratio=x") == std::pair{16ul, ParsingErrorsT::valuenotparsed});
+static_assert(*load_error("weights=1,2") == std::pair{8ul, ParsingErrorsT::vectorvaluenotparsed});
+
+TEST_CASE( "Constant parsing matches the runtime parsing" ) {
+    for (const auto& str : {"50"s, " 50"s, "50 "s, "+50"s, "+-50"s, "-0"s, "-50"s, "5e2"s, ".5"s, "1."s, ""s, "-"s, "0x10"s,
+                            "1,5"s, "007"s, "1e-5"s, "1E+3"s, "18446744073709551615"s, "18446744073709551616"s, "-9223372036854775808"s})
+    {
+        REQUIRE( constant_parse<size_t>(str).valid == simple_parse<size_t>(str).is_valid() );
+        REQUIRE( constant_parse<long>(str).valid == simple_parse<long>(str).is_valid() );
+        REQUIRE( constant_parse<double>(str).valid == simple_parse<double>(str).is_valid() );
+        if (simple_parse<long>(str))
+            REQUIRE( constant_parse<long>(str).value == simple_parse<long>(str).get() );
+        if (simple_parse<double>(str))
+            REQUIRE( constant_parse<double>(str).value == simple_parse<double>(str).get() );
+    }
+
+    std::mt19937_64 gen(42);
+    for (int i = 0; i < 10000; ++i)
+    { // within the exact path: up to 15 digits, exponents within 1e±22
+        const std::string str = std::to_string(gen() % 1000000000000000) + "e" + std::to_string(static_cast<int>(gen() % 45) - 22);
+        REQUIRE( constant_parse<double>(str).value == simple_parse<double>(str).get() );
+        REQUIRE( constant_parse<float>(str).valid == simple_parse<float>(str).is_valid() );
+    }
+    for (const auto& str : {"1e-46"s, "-6e-55"s, "3e-320"s, "1e-400"s, "2e-324"s, "1e39"s, "1e400"s})
+    { // out of range: underflow to zero, overflow in error
+        REQUIRE( constant_parse<float>(str).valid == simple_parse<float>(str).is_valid() );
+        REQUIRE( constant_parse<double>(str).valid == simple_parse<double>(str).is_valid() );
+        if (simple_parse<float>(str))
+            REQUIRE( constant_parse<float>(str).value == simple_parse<float>(str).get() );
+        if (simple_parse<double>(str))
+            REQUIRE( constant_parse<double>(str).value == simple_parse<double>(str).get() );
+    }
+    for (const auto& str : {"1.7976931348623157e308"s, "2.2250738585072014e-308"s, "123456789012345678901234567890"s, "3.14159265358979323846"s})
+        REQUIRE( constant_parse<double>(str).value == simple_parse<double>(str).get() );
+}
+
+TEST_CASE( "Constant parsing of floats is correctly rounded" ) {
+    std::mt19937_64 gen(7);
+    for (int i = 0; i < 10000; ++i)
+    { // up to 17 digits with any exponent: beyond the exact path of double and float
+        const std::string str = std::to_string(gen() % 100000000000000000) + "e" + std::to_string(static_cast<int>(gen() % 90) - 60);
+        REQUIRE( constant_parse<float>(str).valid == simple_parse<float>(str).is_valid() );
+        if (simple_parse<float>(str))
+            REQUIRE( constant_parse<float>(str).value == simple_parse<float>(str).get() );
+        REQUIRE( constant_parse<double>(str).value == simple_parse<double>(str).get() );
+    }
+
+    char buffer[256];
+    for (int i = 0; i < 2000; ++i)
+    { // exact decimal midpoint between two floats, and a hair above and below it
+        const float f = std::ldexp(static_cast<float>(gen() % (1u << 24)), static_cast<int>(gen() % 200) - 140);
+        const double midpoint = (static_cast<double>(f) + std::nextafter(f, std::numeric_limits<float>::infinity())) / 2;
+        std::snprintf(buffer, sizeof(buffer), "%.200e", midpoint);
+        std::string str = buffer;
+        const std::size_t e = str.find('e');
+        std::size_t last = e;
+        while (str[last - 1] == '0')
+            --last;
+        for (const auto& candidate : {str.substr(0, last) + str.substr(e), str.substr(0, last) + "1" + str.substr(e), str.substr(0, 12) + str.substr(e)})
+        {
+            REQUIRE( constant_parse<float>(candidate).valid == simple_parse<float>(candidate).is_valid() );
+            if (simple_parse<float>(candidate))
+                REQUIRE( constant_parse<float>(candidate).value == simple_parse<float>(candidate).get() );
+        }
+    }
+}
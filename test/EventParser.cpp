@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "EventParser.hpp"
+
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+#ifdef CLINIARG_TEST_INSTRUMENTED // built against cliniarg_instrumented: the counter checks must run
+static_assert(instrumentation_enabled);
+#endif
+
+static_assert(std::ranges::input_range<generator<parse_event>>);
+static_assert(std::ranges::view<generator<parse_event>>);
+
+TEST_CASE( "Events of an INI text" ) {
+    const std::string_view text = "a=1\n# comment\n\n[section]\r\nb = two words\nnovalue\n[broken\nc=3"sv;
+    std::vector<parse_event> events;
+    for (const parse_event& e : parse_events(text))
+        events.push_back(e);
+
+    REQUIRE( events.size() == 7 );
+    REQUIRE( events[0].type == event_type::keyvalue );
+    REQUIRE( events[0].key == "a"sv );
+    REQUIRE( events[0].value == "1"sv );
+    REQUIRE( events[0].offset == 0 );
+    REQUIRE( events[1].type == event_type::comment );
+    REQUIRE( events[1].value == "# comment"sv );
+    REQUIRE( events[2].type == event_type::section );
+    REQUIRE( events[2].key == "section"sv );
+    REQUIRE( events[2].offset == 15 );
+    REQUIRE( events[3].key == "b "sv );
+    REQUIRE( events[3].value == " two words"sv );
+    REQUIRE( events[4].type == event_type::error );
+    REQUIRE( events[4].error == ParsingErrorsT::keyvaluenotparsed );
+    REQUIRE( events[4].value == "novalue"sv );
+    REQUIRE( events[5].error == ParsingErrorsT::sectionnotparsed );
+    REQUIRE( events[6].key == "c"sv );
+    REQUIRE( events[6].offset == text.size() - 3 );
+
+    // same events whatever the block size
+    for (std::size_t block_size : {1, 2, 7, 64})
+    {
+        std::size_t i = 0;
+        for (const parse_event& e : parse_events(text, block_size))
+        {
+            REQUIRE( i < events.size() );
+            REQUIRE( e.type == events[i].type );
+            REQUIRE( e.offset == events[i].offset );
+            REQUIRE( e.key == events[i].key );
+            REQUIRE( e.value == events[i].value );
+            ++i;
+        }
+        REQUIRE( i == events.size() );
+    }
+
+    REQUIRE( parse_events(""sv).begin() == std::default_sentinel );
+    REQUIRE( parse_events("\n\r\n"sv).begin() == std::default_sentinel );
+}
+
+TEST_CASE( "Early stop of the event stream" ) {
+    std::string text = "seed=42\n";
+    for (int i = 0; i < 100000; ++i)
+        text += "key" + std::to_string(i) + "=" + std::to_string(i) + "\n";
+
+    text += "[unterminated\n";
+
+    reset_stats();
+    std::size_t seen = 0;
+    int seed = 0;
+    for (const parse_event& e : parse_events(text, 64))
+    {
+        REQUIRE( e.type != event_type::error );
+        ++seen;
+        if (e.type == event_type::keyvalue && e.key == "seed"sv)
+        {
+            seed = simple_parse<int>(e.value).get();
+            break;
+        }
+    }
+    REQUIRE( seed == 42 );
+    REQUIRE( seen == 1 );
+    if (instrumentation_enabled) // only the first block, up to its end of line, was scanned
+        REQUIRE( stats().bytes_scanned < 100 );
+
+    // composed with the standard views, without intermediate vectors
+    auto keys = parse_events(text)
+              | std::views::filter([](const parse_event& e) { return e.type == event_type::keyvalue; })
+              | std::views::drop(1)
+              | std::views::take(3);
+    std::vector<std::string_view> names;
+    for (const parse_event& e : keys)
+        names.push_back(e.key);
+    REQUIRE( names == std::vector{"key0"sv, "key1"sv, "key2"sv} );
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include "CliniParser.hpp"
+#include "Scanner.hpp"
+
+using namespace std::literals;
+
+/**
+ * @brief Payload counting its copies
+ *
+ */
+template <class T>
+struct counted
+{
+    static inline int copies = 0;
+
+    T value;
+
+    explicit counted(T v) : value(std::move(v)) {}
+    counted(const counted& other) : value(other.value) { ++copies; }
+    counted(counted&&) noexcept = default;
+    counted& operator=(const counted& other) { value = other.value; ++copies; return *this; }
+    counted& operator=(counted&&) noexcept = default;
+};
+
+using counted_string = counted<std::string>;
+using counted_vector = counted<std::vector<size_t>>;
+
+static_assert(std::is_nothrow_move_constructible_v<expected<counted_string, FileAndArgsErrorsT>>);
+static_assert(std::is_nothrow_move_constructible_v<expected<void, ParsingErrorsT>>);
+
+TEST_CASE( "File to vector chain without copies" ) {
+    counted_string::copies = 0;
+    counted_vector::copies = 0;
+    const char* buffer = nullptr;
+
+    const auto& values = get_file("test-file.ini")
+        .transform([&](std::string&& content) {
+            buffer = content.data();
+            return counted_string(std::move(content));
+        })
+        .and_then([&](counted_string&& content) {
+            REQUIRE( content.value.data() == buffer ); // the file buffer has been moved, not copied
+            const auto& lines = split_lines(content.value);
+            return vector_parse<size_t>(split_keyvalue_pair(lines.get()[2]).get().second)
+                .transform([](std::vector<size_t>&& v) { return counted_vector(std::move(v)); })
+                .or_else([](ParsingErrorsT) { return expected<counted_vector, FileAndArgsErrorsT>::error(FileAndArgsErrorsT::argerror); });
+        })
+        .transform([](counted_vector&& v) { return std::move(v.value); })
+        .value_or(std::vector<size_t>{});
+
+    REQUIRE( values == std::vector<size_t>{4,5,6} );
+    REQUIRE( counted_string::copies == 0 );
+    REQUIRE( counted_vector::copies == 0 );
+
+    // containers of expected relocate by moves
+    std::vector<expected<counted_vector, ParsingErrorsT>> results;
+    for (size_t i = 0; i < 100; ++i)
+        results.push_back(expected<counted_vector, ParsingErrorsT>::success(std::vector<size_t>(i, i)));
+    REQUIRE( counted_vector::copies == 0 );
+
+    // an lvalue chain copies, as mbind
+    const auto lvalue = expected<counted_vector, ParsingErrorsT>::success(std::vector<size_t>{1});
+    REQUIRE( lvalue.and_then([](const counted_vector& v) { return expected<counted_vector, ParsingErrorsT>::success(v); })->value.size() == 1 );
+    REQUIRE( mbind(lvalue, [](const counted_vector& v) { return expected<size_t, ParsingErrorsT>::success(v.value.size()); }).get() == 1 );
+    REQUIRE( counted_vector::copies == 1 );
+    REQUIRE( mbind(expected<counted_vector, ParsingErrorsT>::success(std::vector<size_t>{1, 2}),
+                   [](counted_vector&& v) { return expected<counted_vector, ParsingErrorsT>::success(std::move(v)); })->value.size() == 2 );
+    REQUIRE( counted_vector::copies == 1 );
+}
+
+TEST_CASE( "Monadic operations on errors" ) {
+    const auto& missing = get_file("no-such-file.ini")
+        .transform([](std::string&& content) { return content.size(); });
+    REQUIRE( missing.error() == FileAndArgsErrorsT::filenotopened );
+    REQUIRE( missing.value_or(42) == 42 );
+
+    const auto& recovered = simple_parse<int>("x"s)
+        .or_else([](ParsingErrorsT e) { return expected<int, ParsingErrorsT>::success(e == ParsingErrorsT::valuenotparsed ? -1 : 0); });
+    REQUIRE( recovered.get() == -1 );
+    REQUIRE( simple_parse<int>("3"s).or_else([](ParsingErrorsT) { return expected<int, ParsingErrorsT>::success(0); }).get() == 3 );
+    REQUIRE( simple_parse<int>("x"s).and_then([](int) { return expected<int, ParsingErrorsT>::success(1); }).error() == ParsingErrorsT::valuenotparsed );
+
+    int calls = 0;
+    const auto& done = expected<void, ParsingErrorsT>::success()
+        .transform([&] { ++calls; return 2; })
+        .and_then([&](int n) { calls += n; return expected<void, ParsingErrorsT>::success(); });
+    REQUIRE( done.is_valid() );
+    REQUIRE( calls == 3 );
+    const auto& failed = expected<void, ParsingErrorsT>::error(ParsingErrorsT::emptyvector)
+        .transform([&] { ++calls; })
+        .or_else([](ParsingErrorsT e) { return expected<void, FileAndArgsErrorsT>::error(e == ParsingErrorsT::emptyvector ? FileAndArgsErrorsT::empty : FileAndArgsErrorsT::argerror); });
+    REQUIRE( failed.error() == FileAndArgsErrorsT::empty );
+    REQUIRE( calls == 3 );
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include "IniIndex.hpp"
+#include "./Settings.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Sectioned INI index" ) {
+    const std::string txt{"oneint=1\n"
+                          "[ Component_A ]\n"
+                          "oneint=2\n"
+                          "# comment\n"
+                          "onevectflot=4,5,6\n"
+                          "[componentb]\r\n"
+                          "One_Int = 3\n"
+                          "onestring=truc\n"
+                          "[ComponentA]\n"
+                          "oneint=4\n"};
+    const auto& res = ini_index::build(txt);
+    REQUIRE( res.is_valid() );
+    const auto& index = res.get();
+    REQUIRE( index.size() == 6 );
+    REQUIRE( index.sections() == std::vector<std::string_view>{""sv, " Component_A "sv, "componentb"sv, "ComponentA"sv} );
+
+    REQUIRE( index.find("", "oneint") == "1"sv );
+    REQUIRE( index.find("componenta", "oneint") == "4"sv ); // last occurrence wins
+    REQUIRE( index.find("Component B", "ONEINT") == " 3"sv );
+    REQUIRE( index.find("componentb", "onevectflot") == std::nullopt );
+    REQUIRE( index.find("componentc", "oneint") == std::nullopt );
+    REQUIRE( index.get<std::vector<float>>("componenta", "onevectflot").get() == std::vector<float>{4,5,6} );
+    REQUIRE( index.get<std::string>("componentb", "onestring").get() == "truc"s );
+    REQUIRE( index.get<size_t>("componentb", "oneint").get() == 3 );
+    REQUIRE( index.get<size_t>("componentb", "nothing").error() == ParsingErrorsT::keynotfound );
+    REQUIRE( index.get<size_t>("componenta", "onevectflot").error() == ParsingErrorsT::valuenotparsed );
+
+    Properties props{};
+    props.onestring = "default"s;
+    REQUIRE( index.load<PropertiesSchema>(props, "componenta").is_valid() );
+    REQUIRE( props.oneint == 4 );
+    REQUIRE( props.onevecfloat == std::vector<float>{4,5,6} );
+    REQUIRE( props.onestring == "default"s );
+}
+
+TEST_CASE( "Sectioned INI errors" ) {
+    const std::string bad_header{"[a]\noneint=1\n[b\noneint=2\n"};
+    REQUIRE( ini_index::build(bad_header).error() == std::pair<std::size_t, ParsingErrorsT>{13, ParsingErrorsT::sectionnotparsed} );
+    REQUIRE( ini_index::build("["sv).error().second == ParsingErrorsT::sectionnotparsed );
+    REQUIRE( ini_index::build("[a]\nno value\n"sv).error() == std::pair<std::size_t, ParsingErrorsT>{4, ParsingErrorsT::keyvaluenotparsed} );
+    REQUIRE( ini_index::build(""sv).get().size() == 0 );
+
+    const std::string bad_value{"[a]\noneint=-1\n"};
+    const auto index = ini_index::build(bad_value).get();
+    Properties props{};
+    REQUIRE( index.load<PropertiesSchema>(props, "a").error() == std::pair<std::size_t, ParsingErrorsT>{11, ParsingErrorsT::valuenotparsed} );
+}
+
+TEST_CASE( "Sectioned INI with many sections" ) {
+    std::string txt;
+    for (size_t s = 0; s < 300; ++s)
+    {
+        txt += "[section_" + std::to_string(s) + "]\n";
+        for (size_t k = 0; k < 20; ++k)
+            txt += "key" + std::to_string(k) + "=" + std::to_string(s * 100 + k) + "\n";
+    }
+    const auto index = ini_index::build(txt).get();
+    REQUIRE( index.size() == 6000 );
+    for (size_t s = 0; s < 300; s += 7)
+        for (size_t k = 0; k < 20; ++k)
+            REQUIRE( index.get<size_t>("Section_" + std::to_string(s), "KEY" + std::to_string(k)).get() == s * 100 + k );
+    REQUIRE( !index.find("section_300", "key0") );
+}
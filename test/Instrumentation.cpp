@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Instrumentation.hpp"
+#include "LayeredConfig.hpp"
+#include "LazyConfig.hpp"
+#include "NumericVector.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+#ifdef CLINIARG_TEST_INSTRUMENTED // built against cliniarg_instrumented: the counter checks must run
+static_assert(instrumentation_enabled);
+#endif
+
+namespace
+{
+    std::vector<parse_stage> finished_stages;
+
+    void record_stage(parse_stage stage, std::uint64_t)
+    {
+        finished_stages.push_back(stage);
+    }
+}
+
+TEST_CASE( "Counters without CLINIARG_INSTRUMENTATION" ) {
+    if (instrumentation_enabled)
+        return;
+    REQUIRE( simple_parse<int>("42"sv).get() == 42 );
+    const parse_stats s = stats();
+    REQUIRE( s.keys == 0 );
+    REQUIRE( s.calls[static_cast<std::size_t>(parse_stage::parse_value)] == 0 );
+    REQUIRE( to_json(s).rfind("{\"enabled\":false,", 0) == 0 );
+}
+
+TEST_CASE( "Counters of a load" ) {
+    if (!instrumentation_enabled)
+        return;
+    reset_stats();
+
+    const std::string text = "a=1\n# comment\nb=x\n[s]\nc=1,2,3\n";
+    auto config = lazy_config::from_string(text);
+    REQUIRE( config.is_valid() );
+    REQUIRE( config.get().get<int>("a").is_valid() );
+    REQUIRE( config.get().get<int>("b").error() == ParsingErrorsT::valuenotparsed );
+    REQUIRE( config.get().get<std::vector<int>>("s", "c").is_valid() );
+
+    const parse_stats s = stats();
+    REQUIRE( s.bytes_scanned >= text.size() );
+    REQUIRE( s.lines == 5 );
+    REQUIRE( s.keys == 3 );
+    REQUIRE( s.calls[static_cast<std::size_t>(parse_stage::split_keyvalue)] == 3 );
+    REQUIRE( s.calls[static_cast<std::size_t>(parse_stage::parse_value)] == 3 );
+    REQUIRE( s.errors[ParsingErrorsT::valuenotparsed] == 1 );
+    REQUIRE( s.allocations >= 1 );
+
+    reset_stats();
+    REQUIRE( stats().keys == 0 );
+    REQUIRE( stats().errors[ParsingErrorsT::valuenotparsed] == 0 );
+}
+
+TEST_CASE( "Errors counted once per value" ) {
+    if (!instrumentation_enabled)
+        return;
+    reset_stats();
+
+    // the element in error is reported by vector_parse only
+    REQUIRE( !vector_parse<int>("1,x"sv) );
+    REQUIRE( !split_keyvalue_pair("novalue"sv) );
+    REQUIRE( !lazy_vector_parse<int>("1:10:0"sv) );
+
+    const parse_stats s = stats();
+    REQUIRE( s.errors[ParsingErrorsT::vectorvaluenotparsed] == 1 );
+    REQUIRE( s.errors[ParsingErrorsT::valuenotparsed] == 0 );
+    REQUIRE( s.errors[ParsingErrorsT::keyvaluenotparsed] == 1 );
+    REQUIRE( s.errors[ParsingErrorsT::rangezerostep] == 1 );
+    REQUIRE( s.calls[static_cast<std::size_t>(parse_stage::parse_value)] == 2 );
+    REQUIRE( s.keys == 0 );
+}
+
+TEST_CASE( "Missing keys counted by every lookup" ) {
+    if (!instrumentation_enabled)
+        return;
+    const std::string text = "a=1\n[s]\nb=2\n";
+    const auto index = ini_index::build(text);
+    auto config = lazy_config::from_string(text);
+    layered_config layers;
+    layers.push(config_layer::from_string("text", text).get());
+    reset_stats();
+
+    REQUIRE( index.get().get<int>("", "b").error() == ParsingErrorsT::keynotfound );
+    REQUIRE( config.get().get<int>("s", "a").error() == ParsingErrorsT::keynotfound );
+    REQUIRE( layers.get<int>("", "c").error() == ParsingErrorsT::keynotfound );
+    REQUIRE( layers.get<int>("s", "b").get() == 2 );
+    REQUIRE( stats().errors[ParsingErrorsT::keynotfound] == 3 );
+}
+
+TEST_CASE( "File reading counters" ) {
+    if (!instrumentation_enabled)
+        return;
+    reset_stats();
+
+    const auto file = get_file("test-file.ini");
+    REQUIRE( file.is_valid() );
+    const auto mapped = map_file("test-file.ini");
+    REQUIRE( mapped.is_valid() );
+
+    const parse_stats s = stats();
+    REQUIRE( s.bytes_read == file.get().size() + mapped.get().size() );
+    REQUIRE( s.calls[static_cast<std::size_t>(parse_stage::read)] == 2 );
+}
+
+TEST_CASE( "Stage callback and JSON dump" ) {
+    if (!instrumentation_enabled)
+        return;
+    reset_stats();
+    finished_stages.clear();
+
+    set_stage_callback(record_stage);
+    const auto lines = split_lines("a=1\nb=2"sv);
+    set_stage_callback(nullptr);
+    REQUIRE( lines.is_valid() );
+    REQUIRE( split_keyvalue_pair("c=3"sv).is_valid() );
+
+    // only the outermost stages are reported, and none after the reset of the callback
+    REQUIRE( finished_stages == std::vector<parse_stage>{parse_stage::tokenize} );
+
+    REQUIRE( !simple_parse<int>("x"sv) );
+    const std::string json = to_json(stats());
+    REQUIRE( json.rfind("{\"enabled\":true,\"stages\":{\"read\":{\"ns\":", 0) == 0 );
+    REQUIRE( json.find("\"tokenize\":{\"ns\":") != std::string::npos );
+    REQUIRE( json.find("\"lines\":2,\"keys\":1,") != std::string::npos );
+    REQUIRE( json.find("\"errors\":{\"valuenotparsed\":1}}") != std::string::npos );
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include "KeyIndex.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Perfect hash key lookup" ) {
+    constexpr auto index = make_key_index("oneint", "onevectflot", "onestring");
+    static_assert( index.find("one_Int") == 0 );
+    REQUIRE( index.find("oneint"sv) == 0 );
+    REQUIRE( index.find(" One Vect_Flot\t"sv) == 1 );
+    REQUIRE( index.find("ONESTRING"sv) == 2 );
+    REQUIRE( index.find("onestrin"sv) == index.npos );
+    REQUIRE( index.find(""sv) == index.npos );
+    REQUIRE( index.lookup("one_string"sv).get() == 2 );
+    REQUIRE( index.lookup("truc"sv).error() == ParsingErrorsT::keynotfound );
+    REQUIRE( index.name(1) == "onevectflot"sv );
+}
+
+/**
+ * @brief 300 keys "param000" ... "param299" in static storage
+ * 
+ */
+constexpr auto many_key_chars = [] {
+    std::array<char, 300 * 8> chars{};
+    for (size_t i = 0; i < 300; ++i)
+    {
+        const char key[] = {'p','a','r','a','m', char('0' + i / 100), char('0' + i / 10 % 10), char('0' + i % 10)};
+        for (size_t c = 0; c < 8; ++c)
+            chars[i * 8 + c] = key[c];
+    }
+    return chars;
+}();
+
+constexpr auto many_keys = [] {
+    std::array<std::string_view, 300> keys{};
+    for (size_t i = 0; i < 300; ++i)
+        keys[i] = std::string_view(many_key_chars.data() + i * 8, 8);
+    return keys;
+}();
+
+TEST_CASE( "Perfect hash with many keys" ) {
+    static constexpr key_index<300> index{many_keys};
+    for (size_t i = 0; i < 300; ++i)
+    {
+        REQUIRE( index.find(many_keys[i]) == i );
+        std::string upper{many_keys[i]};
+        upper[0] = 'P';
+        upper.insert(5, "_");
+        REQUIRE( index.find(upper) == i );
+    }
+    REQUIRE( index.find("param300"sv) == index.npos );
+}
@@ -23,3 +23,24 @@ TEST_CASE( "Key/Value splitting") {
     const auto& res4 = split_keyvalue_pair(res3.get().second);
     REQUIRE( distance(begin(txt4),begin(res4.get().second))  == 19 );
 }
+
+TEST_CASE( "Key/Value splitting errors and regex equivalence") {
+    std::string txt{"trucmachin"};
+    const auto& res = split_keyvalue_pair(txt);
+    REQUIRE( !res.is_valid() );
+    REQUIRE( res.error().first == begin(txt) );
+    REQUIRE( res.error().second == ParsingErrorsT::keyvaluenotparsed );
+
+    for (const std::string& line : {"a=b"s, "=b"s, "a="s, "="s, ""s, "a==b"s, " a = b "s, "a=b\nc"s, "a\nb=c"s, "a=b\r"s})
+    {
+        std::smatch m;
+        const bool matched = std::regex_search(line, m, keyvalue_re);
+        const auto& kv = split_keyvalue_pair(line);
+        REQUIRE( kv.is_valid() == matched );
+        if (matched)
+        {
+            REQUIRE( to<std::string>(kv.get().first) == m.str(1) );
+            REQUIRE( to<std::string>(kv.get().second) == m.str(2) );
+        }
+    }
+}
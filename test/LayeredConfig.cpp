@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LayeredConfig.hpp"
+#include "./Settings.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Layered configuration precedence" ) {
+    const char* const environment[] = {"PATH=/usr/bin", "CLINI_ONE_STRING=from env", "CLINI_=1", "CLINI_NOVALUE=",
+                                       "CLINI_[X]=1", "CLINI_MULTI=a\nb", "OTHER_ONEINT=8", nullptr};
+    layered_config config;
+    config.push(config_layer::from_string("defaults", "oneint=1\nonestring=default\nonevectflot=0\n[comp]\noneint=10\n").get())
+          .push(config_layer::from_file("test-file.ini").get())
+          .push(config_layer::from_environment("CLINI_", environment))
+          .push(config_layer::from_command_line("oneint=3 \t onevectflot=1.5,2.5").get());
+    REQUIRE( config.size() == 4 );
+    REQUIRE( config.layer(1).name() == "test-file.ini"s );
+    REQUIRE( config.layer(2).size() == 1 );
+    REQUIRE( config.find("", "onestring")->data() == environment[1] + 17 ); // in place
+
+    REQUIRE( config.find("", "oneint") == "3"sv );
+    REQUIRE( config.find("", "onestring") == "from env"sv );
+    REQUIRE( config.find("", "truc") == "machin"sv );
+    REQUIRE( config.find("comp", "oneint") == "10"sv );
+    REQUIRE( config.find_layer("", "bidule")->first == 1 );
+    REQUIRE( !config.find("", "nothing") );
+    REQUIRE( config.get<size_t>("", "oneint").get() == 3 );
+    REQUIRE( config.get<size_t>("", "nothing").error() == ParsingErrorsT::keynotfound );
+
+    // views into the layer buffers, no copy
+    const auto value = *config.find("", "onevectflot");
+    REQUIRE( value.data() >= config.layer(3).index().source().data() );
+    REQUIRE( value.data() < config.layer(3).index().source().data() + config.layer(3).index().source().size() );
+
+    Properties props{};
+    REQUIRE( config.load<PropertiesSchema>(props).is_valid() );
+    REQUIRE( props.oneint == 3 );
+    REQUIRE( props.onevecfloat == std::vector<float>{1.5f,2.5f} );
+    REQUIRE( props.onestring == "from env"s );
+    REQUIRE( config.load<PropertiesSchema>(props, "comp").is_valid() );
+    REQUIRE( props.oneint == 10 );
+}
+
+TEST_CASE( "Layered configuration errors" ) {
+    REQUIRE( std::get<FileAndArgsErrorsT>(config_layer::from_file("no-such-file.ini").error()) == FileAndArgsErrorsT::filenotopened );
+    REQUIRE( config_layer::from_string("defaults", "[a\n").error() == std::pair<std::size_t, ParsingErrorsT>{0, ParsingErrorsT::sectionnotparsed} );
+    REQUIRE( config_layer::from_command_line("oneint=2 bad").error() == std::pair<std::size_t, ParsingErrorsT>{9, ParsingErrorsT::keyvaluenotparsed} );
+
+    layered_config config;
+    config.push(config_layer::from_string("defaults", "oneint=1\n").get())
+          .push(config_layer::from_command_line("onestring=x oneint=-2").get());
+    Properties props{};
+    const auto& res = config.load<PropertiesSchema>(props);
+    REQUIRE( res.error().layer == 1 );
+    REQUIRE( res.error().offset == 19 );
+    REQUIRE( res.error().error == ParsingErrorsT::valuenotparsed );
+
+#ifndef _WIN32
+    ::setenv("CLINIARG_TEST_ONEINT", "12", 1);
+    REQUIRE( config_layer::from_environment("CLINIARG_TEST_").find("", "oneint") == "12"sv );
+    ::unsetenv("CLINIARG_TEST_ONEINT");
+#endif
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LazyConfig.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Values parsed on first access" ) {
+    auto config = lazy_config::from_string("oneint=2\nonevectflot=4,5,6\n# comment\nbad=x\n[comp]\none_int=7\noneint=8\n").get();
+    REQUIRE( config.size() == 4 ); // one_int and oneint are the same key
+    REQUIRE( config.parsed() == 0 );
+
+    const auto& oneint = config.get<size_t>("One Int");
+    REQUIRE( *oneint.get() == 2 );
+    REQUIRE( config.parsed() == 1 );
+    REQUIRE( config.get<size_t>("oneint").get() == oneint.get() ); // cached, same object
+    REQUIRE( config.parsed() == 1 );
+
+    REQUIRE( *config.get<std::vector<float>>("onevectflot").get() == std::vector<float>{4,5,6} );
+    REQUIRE( *config.get<std::string>("onevectflot").get() == "4,5,6"s ); // another type, parsed again
+    REQUIRE( config.parsed() == 3 );
+    REQUIRE( config.get<lazy_vector<int>>("onevectflot").get()->to_vector() == std::vector<int>{4,5,6} );
+
+    REQUIRE( *config.get<int>("comp", "oneint").get() == 8 );
+    REQUIRE( config.get<int>("bad").error() == ParsingErrorsT::valuenotparsed );
+    REQUIRE( config.get<int>("nothing").error() == ParsingErrorsT::keynotfound );
+    REQUIRE( config.find("", "bad") == "x"sv );
+
+    REQUIRE( lazy_config::from_string("a=1\n[oops\n").error().second == ParsingErrorsT::sectionnotparsed );
+}
+
+TEST_CASE( "Lazy configuration from a file" ) {
+    auto config = lazy_config::from_file("test-file.ini");
+    REQUIRE( config.is_valid() );
+    REQUIRE( *config.get().get<std::string>("truc").get() == "machin"s );
+    REQUIRE( config.get().parsed() == 1 );
+    REQUIRE( std::holds_alternative<FileAndArgsErrorsT>(lazy_config::from_file("nothing.ini").error()) );
+}
+
+TEST_CASE( "Lazy configuration index matches ini_index" ) {
+    std::string str;
+    for (int i = 0; i < 5000; ++i)
+    {
+        if (i % 100 == 0)
+            str += "[section " + std::to_string(i / 100) + "]\n";
+        str += "key_" + std::to_string(i % 700) + " = " + std::to_string(i) + "\n";
+    }
+    const auto& index = ini_index::build(str);
+    auto config = lazy_config::from_string(str).get();
+    REQUIRE( config.source() == str );
+    for (int s = 0; s < 50; ++s)
+        for (int k = 0; k < 700; k += 7)
+        {
+            const std::string section = "Section" + std::to_string(s);
+            const std::string key = "KEY" + std::to_string(k);
+            REQUIRE( config.find(section, key) == index.get().find(section, key) );
+        }
+    REQUIRE( !config.find("", "key_1") );
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LazyVector.hpp"
+#include "Schema.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace std::literals;
+
+static_assert(std::random_access_iterator<lazy_vector<int>::iterator>);
+
+TEST_CASE( "Range notation in vector values" ) {
+    const auto& ints = lazy_vector_parse<int>("1,2,5:10,20:100:10"sv);
+    REQUIRE( ints.is_valid() );
+    REQUIRE( ints.get().to_vector() == std::vector<int>{1,2,5,6,7,8,9,10,20,30,40,50,60,70,80,90,100} );
+    REQUIRE( ints.get().size() == 17 );
+    REQUIRE( ints.get()[7] == 10 );
+    REQUIRE( ints.get().front() == 1 );
+    REQUIRE( ints.get().back() == 100 );
+
+    const auto sweep = lazy_vector_parse<long>("1:10000000"sv).get();
+    REQUIRE( sweep.size() == 10000000 );
+    REQUIRE( sweep.segments() == 1 );
+    REQUIRE( sweep[9999999] == 10000000 );
+    REQUIRE( *std::lower_bound(sweep.begin(), sweep.end(), 4242) == 4242 );
+    REQUIRE( std::distance(sweep.begin(), sweep.end()) == 10000000 );
+
+    // equally spaced numbers are stored as one progression
+    REQUIRE( lazy_vector_parse<int>("1,2,3,4:10"sv).get().segments() == 1 );
+    REQUIRE( lazy_vector_parse<int>("1,3,5,7,2"sv).get().segments() == 2 );
+
+    REQUIRE( lazy_vector_parse<unsigned>("10:1:-3"sv).get().to_vector() == std::vector<unsigned>{10,7,4,1} );
+    REQUIRE( lazy_vector_parse<int>("-2:2, 7:7"sv).get().to_vector() == std::vector<int>{-2,-1,0,1,2,7} );
+    REQUIRE( lazy_vector_parse<short>("-32768:32767:13107"sv).get().to_vector() == std::vector<short>{-32768,-19661,-6554,6553,19660,32767} );
+    REQUIRE( lazy_vector_parse<double>("0:0.3:0.1"sv).get().size() == 4 );
+    REQUIRE( lazy_vector_parse<double>("0.5,1:2:0.25"sv).get().to_vector() == std::vector<double>{0.5,1,1.25,1.5,1.75,2} );
+    REQUIRE( lazy_vector_parse<int>(",1,,2,"sv).get().to_vector() == std::vector<int>{1,2} );
+    REQUIRE( lazy_vector_parse<int>("1,2,3,7"sv).get().to_vector() == std::vector<int>{1,2,3,7} );
+    REQUIRE( lazy_vector_parse<float>("1.5,2,7.25"sv).get().to_vector() == std::vector<float>{1.5f,2,7.25f} );
+}
+
+TEST_CASE( "Range notation errors" ) {
+    REQUIRE( lazy_vector_parse<int>(""sv).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( lazy_vector_parse<int>(",,"sv).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( lazy_vector_parse<int>("1,x"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( lazy_vector_parse<unsigned>("1,-2"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( lazy_vector_parse<int>("1:"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<int>(":3"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<int>("1:3:"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<int>("1:3:1:2"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<int>("1:3.5"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<unsigned>("0:-3"sv).error() == ParsingErrorsT::rangenotparsed );
+    REQUIRE( lazy_vector_parse<int>("1:3:0"sv).error() == ParsingErrorsT::rangezerostep );
+    REQUIRE( lazy_vector_parse<double>("1:3:0.0"sv).error() == ParsingErrorsT::rangezerostep );
+    REQUIRE( lazy_vector_parse<int>("3:1"sv).error() == ParsingErrorsT::rangewrongdirection );
+    REQUIRE( lazy_vector_parse<int>("1:3:-1"sv).error() == ParsingErrorsT::rangewrongdirection );
+}
+
+struct SweepProperties
+{
+    lazy_vector<double> rates;
+    std::vector<int> seeds;
+};
+
+using SweepSchema = schema<
+    field<"rates", &SweepProperties::rates>,
+    field<"seeds", &SweepProperties::seeds>>;
+
+TEST_CASE( "Lazy vector members in a schema" ) {
+    SweepProperties props{};
+    REQUIRE( SweepSchema::assign(props, "rates"sv, "0:1:0.5,10"sv).is_valid() );
+    REQUIRE( props.rates.to_vector() == std::vector<double>{0,0.5,1,10} );
+    REQUIRE( SweepSchema::assign(props, "rates"sv, "1:0"sv).error() == ParsingErrorsT::rangewrongdirection );
+    REQUIRE( SweepSchema::assign(props, "seeds"sv, "1:3"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include "LiveConfig.hpp"
+#include "./Settings.hpp"
+#include "./TestFiles.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Snapshot publication" ) {
+    snapshot_cell<std::vector<int>> cell{{1, 2}};
+    snapshot_reader<std::vector<int>> reader(cell);
+    const auto first = cell.load();
+    REQUIRE( cell.version() == 0 );
+
+    cell.publish({3});
+    REQUIRE( cell.version() == 1 );
+    REQUIRE( *first == std::vector<int>{1, 2} ); // held snapshots are never modified
+    REQUIRE( *cell.load() == std::vector<int>{3} );
+    REQUIRE( reader->size() == 1 );
+
+    // readers see whole snapshots while another thread publishes
+    std::atomic<bool> consistent{true};
+    std::thread writer([&] {
+        for (int i = 0; i < 2000; ++i)
+            cell.publish(std::vector<int>(i % 17, i));
+    });
+    for (int r = 0; r < 20000; ++r)
+    {
+        const auto& v = reader.get();
+        consistent = consistent && std::all_of(v.begin(), v.end(), [&](int x) { return x == v.front(); });
+    }
+    writer.join();
+    REQUIRE( consistent );
+    REQUIRE( reader->size() == 1999 % 17 );
+}
+
+TEST_CASE( "Live configuration reload" ) {
+    const auto path = std::filesystem::temp_directory_path() / "cliniarg_test_live.ini";
+    write_text(path, "oneint=2\nonevectflot=4,5,6\n");
+
+    Properties defaults{};
+    defaults.onestring = "default"s;
+    live_config<PropertiesSchema> config(path.string(), defaults, false);
+    REQUIRE( !config.last_error() );
+    REQUIRE( config.version() == 1 );
+    const auto first = config.snapshot();
+    REQUIRE( first->oneint == 2 );
+    REQUIRE( first->onestring == "default"s );
+    auto reader = config.reader();
+
+    write_text(path, "oneint=3\nonestring=truc\n");
+    REQUIRE( config.reload().is_valid() );
+    REQUIRE( first->oneint == 2 );
+    REQUIRE( reader->oneint == 3 );
+    REQUIRE( reader->onevecfloat.empty() ); // removed keys get back their default
+    REQUIRE( reader->onestring == "truc"s );
+
+    write_text(path, "oneint=3\nunknown=1\n");
+    REQUIRE( std::get<1>(config.reload().error()) == std::pair<std::size_t, ParsingErrorsT>{9, ParsingErrorsT::keynotfound} );
+    REQUIRE( config.last_error() );
+    REQUIRE( config.version() == 2 );
+    REQUIRE( reader->onestring == "truc"s );
+
+    std::filesystem::remove(path);
+    REQUIRE( std::get<FileAndArgsErrorsT>(config.reload().error()) == FileAndArgsErrorsT::filenotopened );
+    live_config<PropertiesSchema> missing(path.string(), defaults, false);
+    REQUIRE( missing.last_error() );
+    REQUIRE( missing.snapshot()->onestring == "default"s );
+}
+
+TEST_CASE( "Live configuration watching" ) {
+    const auto path = std::filesystem::temp_directory_path() / "cliniarg_test_live_watch.ini";
+    write_text(path, "oneint=2\n");
+
+    live_config<PropertiesSchema> config(path.string(), {}, true, std::chrono::milliseconds{10});
+    auto reader = config.reader();
+    REQUIRE( reader->oneint == 2 );
+
+    // some file systems only keep the modification time to the second
+    std::this_thread::sleep_for(std::chrono::milliseconds{1100});
+    const auto tmp = path.string() + ".tmp";
+    write_text(tmp, "oneint=5\n");
+    std::filesystem::rename(tmp, path);
+    for (int i = 0; i < 500 && config.version() < 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    REQUIRE( reader->oneint == 5 );
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE( "Live configuration watching without inotify" ) {
+    // the directory does not exist yet: no inotify watch, the modification time is polled
+    const auto dir = std::filesystem::temp_directory_path() / "cliniarg_test_live_missing";
+    std::filesystem::remove_all(dir);
+    const auto path = dir / "live.ini";
+    live_config<PropertiesSchema> config(path.string(), {}, true, std::chrono::milliseconds{10});
+    REQUIRE( config.last_error() );
+
+    std::filesystem::create_directories(dir);
+    write_text(dir / "live.tmp", "oneint=7\n");
+    std::filesystem::rename(dir / "live.tmp", path);
+    for (int i = 0; i < 500 && config.version() < 1; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    REQUIRE( config.snapshot()->oneint == 7 );
+    REQUIRE( !config.last_error() );
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MappedFile.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Mapped file reading" ) {
+    const auto& res_file = map_file("test-file.ini");
+    REQUIRE( res_file.is_valid() );
+    const auto& file = res_file.get();
+    REQUIRE( file.is_mapped() );
+    REQUIRE( file.view() == get_file("test-file.ini").get() );
+
+    const auto& vecres_rng = split_token(file, fileline_re);
+    REQUIRE( vecres_rng.is_valid() );
+    const auto& vecres = vecres_rng.get();
+    REQUIRE( begin(vecres[0]) == file.data() );
+    REQUIRE( to<std::string>(vecres[2]) == "blah=4,5,6"s );
+
+    const auto& pairvec = split_keyvalue_pair(vecres[2]);
+    REQUIRE( pairvec.is_valid() );
+    REQUIRE( begin(pairvec.get().second) == file.data() + 71 );
+    REQUIRE( vector_parse<size_t>(pairvec.get().second).get() == std::vector<size_t>{4,5,6} );
+}
+
+TEST_CASE( "Mapped file errors and fallback" ) {
+    REQUIRE( map_file("no-such-file.ini").error() == FileAndArgsErrorsT::filenotopened );
+
+#ifdef __linux__
+    // procfs files report a zero size and must be read
+    const auto& res_proc = map_file("/proc/self/status");
+    REQUIRE( res_proc.is_valid() );
+    REQUIRE( !res_proc.get().is_mapped() );
+    REQUIRE( res_proc.get().view().find("Name:") != std::string_view::npos );
+#endif
+
+    auto moved = std::move(map_file("test-file.ini").get());
+    mapped_file small{"truc=machin"s};
+    small = std::move(moved);
+    REQUIRE( small.view().substr(0, 11) == "truc=machin"sv );
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include "NumericVector.hpp"
+
+#include <random>
+
+using namespace std::literals;
+
+TEST_CASE( "Bulk numeric vector parsing" ) {
+    REQUIRE( numeric_vector_parse<size_t>("1,2,3"sv).get() == std::vector<size_t>{1,2,3} );
+    REQUIRE( numeric_vector_parse<size_t>("1,-2,3"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( numeric_vector_parse<size_t>("1,2,3.5"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( numeric_vector_parse<size_t>("1,2,3x"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( numeric_vector_parse<double>("1,-2,3.5"sv).get() == std::vector<double>{1,-2,3.5} );
+    REQUIRE( numeric_vector_parse<int>(" +1, 2,,3,"sv).get() == std::vector<int>{1,2,3} );
+    REQUIRE( numeric_vector_parse<int>(""sv).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( numeric_vector_parse<int>(",,"sv).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( numeric_vector_parse<int>("1,#2"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+}
+
+TEST_CASE( "Bulk numeric vector parsing matches vector_parse" ) {
+    const std::string alphabet{"0123456789,,,-+. e"};
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+    for (int round = 0; round < 300; ++round)
+    {
+        std::string str(std::uniform_int_distribution<std::size_t>(0, 200)(gen), ' ');
+        for (auto& c : str)
+            c = alphabet[pick(gen)];
+
+        for (std::size_t threads : {1, 4})
+        {
+            const auto& ints = numeric_vector_parse<int>(str, threads, 16);
+            const auto& ref_ints = vector_parse<int>(str);
+            REQUIRE( ints.is_valid() == ref_ints.is_valid() );
+            if (ints)
+                REQUIRE( ints.get() == ref_ints.get() );
+            else
+                REQUIRE( ints.error() == ref_ints.error() );
+
+            const auto& unsigneds = numeric_vector_parse<unsigned>(str, threads, 16);
+            const auto& ref_unsigneds = vector_parse<unsigned>(str);
+            REQUIRE( unsigneds.is_valid() == ref_unsigneds.is_valid() );
+            if (unsigneds)
+                REQUIRE( unsigneds.get() == ref_unsigneds.get() );
+
+            const auto& doubles = numeric_vector_parse<double>(str, threads, 16);
+            const auto& ref_doubles = vector_parse<double>(str);
+            REQUIRE( doubles.is_valid() == ref_doubles.is_valid() );
+            if (doubles)
+                REQUIRE( doubles.get() == ref_doubles.get() );
+        }
+    }
+}
+
+TEST_CASE( "Bulk numeric vector parsing in parallel chunks" ) {
+    std::string str;
+    std::vector<long> expected_values;
+    for (long i = 0; i < 100000; ++i)
+    {
+        str += std::to_string(i % 2 ? -i : i) + (i % 7 ? "," : ",,");
+        expected_values.push_back(i % 2 ? -i : i);
+    }
+    const auto& parallel = numeric_vector_parse<long>(str, 8, 1024);
+    REQUIRE( parallel.get() == expected_values );
+    REQUIRE( numeric_vector_parse<long>(str, 8).get() == expected_values );
+
+    str += "12x,1";
+    REQUIRE( numeric_vector_parse<long>(str, 8, 1024).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( numeric_vector_parse<unsigned long>("1,2,"s + str, 8, 1024).error() == ParsingErrorsT::vectorvaluenotparsed );
+}
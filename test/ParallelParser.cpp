@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ParallelParser.hpp"
+#include "./Settings.hpp"
+
+using namespace std::literals;
+
+/**
+ * @brief Configuration with every key repeated many times, and comments
+ *
+ */
+std::string make_repeated_config(size_t lines)
+{
+    std::string txt;
+    for (size_t i = 0; i < lines; ++i)
+        switch (i % 4)
+        {
+        case 0: txt += "one_int = " + std::to_string(i) + "\n"; break;
+        case 1: txt += "OneVectFlot=" + std::to_string(i) + ",0.5," + std::to_string(i % 7) + "\r\n"; break;
+        case 2: txt += "# comment " + std::to_string(i) + "\n"; break;
+        default: txt += "onestring=value" + std::to_string(i) + "\n";
+        }
+    return txt;
+}
+
+TEST_CASE( "Parallel loading, last occurrence wins" ) {
+    const std::string txt = make_repeated_config(1001);
+    Properties sequential{};
+    REQUIRE( PropertiesSchema::load(sequential, split_token(txt, fileline_re).get()).is_valid() );
+
+    for (size_t threads : {1, 2, 3, 7, 16})
+    {
+        Properties props{};
+        REQUIRE( parallel_load<PropertiesSchema>(props, txt, threads, 1).is_valid() );
+        REQUIRE( props.oneint == sequential.oneint );
+        REQUIRE( props.onevecfloat == sequential.onevecfloat );
+        REQUIRE( props.onestring == sequential.onestring );
+    }
+    REQUIRE( sequential.oneint == 1000 );
+
+    Properties props{};
+    REQUIRE( parallel_load<PropertiesSchema>(props, ""s, 4, 1).is_valid() );
+    REQUIRE( parallel_load<PropertiesSchema>(props, "\n\n# only a comment\n"s, 4, 1).is_valid() );
+}
+
+TEST_CASE( "Parallel loading, first error in input order" ) {
+    const std::string good = make_repeated_config(400);
+    for (auto bad_line : {"oneint=-3\n"s, "unknown=3\n"s, "no value here\n"s, "onevectflot=1,x\n"s})
+        for (size_t at : {size_t{0}, good.size() / 3, good.size() / 2, good.size()})
+        {
+            const size_t line_start = good.find('\n', at == 0 ? 0 : at - 1);
+            const std::string head = at == 0 ? ""s : good.substr(0, line_start + 1);
+            const std::string txt = head + bad_line + (at == 0 ? good : good.substr(head.size())) + bad_line;
+
+            Properties sequential{};
+            const auto& expected_res = PropertiesSchema::load(sequential, split_token(txt, fileline_re).get());
+            REQUIRE_FALSE( expected_res.is_valid() );
+            for (size_t threads : {1, 2, 5, 9})
+            {
+                Properties props{};
+                const auto& res = parallel_load<PropertiesSchema>(props, txt, threads, 1);
+                REQUIRE_FALSE( res.is_valid() );
+                REQUIRE( res.error().first - begin(txt) == expected_res.error().first - begin(txt) );
+                REQUIRE( res.error().second == expected_res.error().second );
+                REQUIRE( props.oneint == sequential.oneint );
+                REQUIRE( props.onevecfloat == sequential.onevecfloat );
+                REQUIRE( props.onestring == sequential.onestring );
+            }
+        }
+}
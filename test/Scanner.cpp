@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Scanner.hpp"
+
+#include <random>
+
+using namespace std::literals;
+
+TEST_CASE( "Vectorized line and argument splitting" ) {
+    const auto& res_str = get_file("test-file.ini");
+    const auto& vecres_rng = split_lines(res_str.get());
+    REQUIRE( vecres_rng.is_valid() );
+    const auto& vecres = vecres_rng.get();
+    REQUIRE( vecres.size() == 3 );
+    REQUIRE( to<std::string>(vecres[0]) == "truc=machin"s );
+    REQUIRE( to<std::string>(vecres[2]) == "blah=4,5,6"s );
+    REQUIRE( distance(begin(res_str.get()), begin(vecres[2])) == 66 );
+
+    const std::string cmd_str{R"#(truc=machin bidule=2	blah=4,5,6)#"};
+    const auto& args_rng = split_args(cmd_str);
+    REQUIRE( args_rng.is_valid() );
+    const auto& args = args_rng.get();
+    REQUIRE( args.size() == 3 );
+    REQUIRE( to<std::string>(args[1]) == "bidule=2"s );
+
+    REQUIRE( split_lines("\n\r\n# only comments\n"s).error() == FileAndArgsErrorsT::empty );
+}
+
+TEST_CASE( "Vectorized splitting matches the regex tokenization" ) {
+    const std::string alphabet{"ab=,#% \t\n\r\v\f"};
+    std::mt19937 gen(42);
+    for (size_t n = 0; n < 500; ++n)
+    {
+        std::string str(std::uniform_int_distribution<size_t>(0, 300)(gen), ' ');
+        for (auto& c : str)
+            c = alphabet[std::uniform_int_distribution<size_t>(0, alphabet.size() - 1)(gen)];
+
+        const auto to_offsets = [&str](auto&& res) {
+            std::vector<std::pair<long,long>> offsets;
+            if (res.is_valid())
+                for (auto&& t : res.get())
+                    offsets.emplace_back(distance(begin(str), begin(t)), distance(begin(str), end(t)));
+            return offsets;
+        };
+        const auto lines = to_offsets(split_token(str, fileline_re));
+        const auto args = to_offsets(split_token(str, commandline_re));
+        const auto elements = to_offsets(split_token(str, vector_re));
+        for (auto level : {simd_level::scalar, simd_level::sse2, simd_level::avx2})
+        {
+            if (level > detected_simd_level())
+                continue;
+            REQUIRE( to_offsets(scan_tokens<scan_class::line>(str, level)) == lines );
+            REQUIRE( to_offsets(scan_tokens<scan_class::space>(str, level)) == args );
+            REQUIRE( to_offsets(scan_tokens<scan_class::comma>(str, level)) == elements );
+        }
+    }
+}
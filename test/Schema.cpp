@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Schema.hpp"
+#include "./Settings.hpp"
+
+using namespace std::literals;
+
+TEST_CASE( "Schema dispatch" ) {
+    Properties props{};
+    REQUIRE( PropertiesSchema::assign(props, "oneint"sv, "9"sv).is_valid() );
+    REQUIRE( PropertiesSchema::assign(props, "onevectflot"sv, "3.5,2.25"sv).is_valid() );
+    REQUIRE( PropertiesSchema::assign(props, "onestring"sv, "trucmachin"sv).is_valid() );
+    REQUIRE( PropertiesSchema::assign(props, "One_Int "sv, "9"sv).is_valid() );
+    REQUIRE( props.oneint == 9 );
+    REQUIRE( props.onevecfloat == std::vector<float>{3.5f,2.25f} );
+    REQUIRE( props.onestring == "trucmachin"s );
+
+    REQUIRE( PropertiesSchema::assign(props, "truc"sv, "9"sv).error() == ParsingErrorsT::keynotfound );
+    REQUIRE( PropertiesSchema::assign(props, "oneint"sv, "-9"sv).error() == ParsingErrorsT::valuenotparsed );
+    REQUIRE( PropertiesSchema::assign(props, "onevectflot"sv, "3.5,x"sv).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( props.oneint == 9 );
+}
+
+TEST_CASE( "Schema loading" ) {
+    const std::string txt{"oneint=2\n# comment\nonevectflot=4,5,6\nonestring=machin\noneint=3"};
+    const auto& lines = split_token(txt, fileline_re);
+    Properties props{};
+    REQUIRE( PropertiesSchema::load(props, lines.get()).is_valid() );
+    REQUIRE( props.oneint == 3 );
+    REQUIRE( props.onevecfloat == std::vector<float>{4,5,6} );
+    REQUIRE( props.onestring == "machin"s );
+
+    const std::string bad{"oneint=2\nunknown=5"};
+    const auto& res = PropertiesSchema::load(props, split_token(bad, fileline_re).get());
+    REQUIRE( res.error().first == begin(bad) + 9 );
+    REQUIRE( res.error().second == ParsingErrorsT::keynotfound );
+
+    const std::string bad_value{"oneint=2.5"};
+    const auto& res_value = PropertiesSchema::load(props, split_token(bad_value, fileline_re).get());
+    REQUIRE( res_value.error().first == begin(bad_value) + 7 );
+}
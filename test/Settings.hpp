@@ -13,6 +13,8 @@
 #include <vector>
 #include <map>
 
+#include "Schema.hpp"
+
 /**
  * @brief Parameters enum
  * 
@@ -44,4 +46,11 @@ struct Properties {
     std::string onestring;
 };
 
-
+/**
+ * @brief Declarative binding of the keys to the Properties members
+ * 
+ */
+using PropertiesSchema = schema<
+    field<"oneint", &Properties::oneint>,
+    field<"onevectflot", &Properties::onevecfloat>,
+    field<"onestring", &Properties::onestring>>;
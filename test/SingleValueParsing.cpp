@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "CliniParser.hpp"
 
+#include <cmath>
+
 using namespace std::literals;
 
 TEST_CASE( "Various single value parsing") {
@@ -12,3 +14,48 @@ TEST_CASE( "Various single value parsing") {
     REQUIRE( simple_parse<double>("-2.3"s).get() == -2.3 );
 
 }
+
+TEST_CASE( "from_chars parsing follows the stream rules") {
+    REQUIRE( !simple_parse<int>("3.5"s).is_valid() );
+    REQUIRE( !simple_parse<int>("99999999999"s).is_valid() );
+    REQUIRE( !simple_parse<double>("inf"s).is_valid() );
+    REQUIRE( simple_parse<float>("2.5"s).get() == 2.5f );
+    REQUIRE( simple_parse<std::string>("trucmachin"s).get() == "trucmachin"s );
+
+    const std::string line{"bidule=42"};
+    REQUIRE( simple_parse<unsigned>(subrange(begin(line) + 7, end(line))).get() == 42u );
+
+    for (const auto& str : {"50"s, " 50"s, "50 "s, "+50"s, "+-50"s, "-0"s, "-50"s, "5e2"s, ".5"s, "1."s, ""s, "-"s, "0x10"s, "1,5"s})
+    {
+        REQUIRE( simple_parse<size_t>(str).is_valid() == ::detail::stream_parse<size_t>(str).is_valid() );
+        REQUIRE( simple_parse<int>(str).is_valid() == ::detail::stream_parse<int>(str).is_valid() );
+        REQUIRE( simple_parse<double>(str).is_valid() == ::detail::stream_parse<double>(str).is_valid() );
+        if (simple_parse<double>(str).is_valid())
+            REQUIRE( simple_parse<double>(str).get() == ::detail::stream_parse<double>(str).get() );
+    }
+}
+
+TEST_CASE( "Out of range floating values follow the stream rules") {
+    // underflow: a zero of the sign of the input
+    for (const auto& str : {"1e-46"s, "6e-55"s, "3e-320"s, "-1e-46"s, "0.000001e-40"s, "1e-99999999999"s})
+    {
+        REQUIRE( simple_parse<float>(str).get() == 0.0f );
+        REQUIRE( std::signbit(simple_parse<float>(str).get()) == (str[0] == '-') );
+        REQUIRE( simple_parse<float>(str).get() == ::detail::stream_parse<float>(str).get() );
+    }
+    for (const auto& str : {"1e-400"s, "2e-324"s, "-2e-324"s})
+    {
+        REQUIRE( simple_parse<double>(str).get() == 0.0 );
+        REQUIRE( std::signbit(simple_parse<double>(str).get()) == (str[0] == '-') );
+    }
+    REQUIRE( simple_parse<double>("3e-324"s).get() == std::numeric_limits<double>::denorm_min() );
+
+    // overflow: an error
+    for (const auto& str : {"1e39"s, "-1e39"s, "340282356779733661637539395458142568448"s, "0.1e40"s})
+    {
+        REQUIRE( !simple_parse<float>(str).is_valid() );
+        REQUIRE( !::detail::stream_parse<float>(str).is_valid() );
+    }
+    REQUIRE( !simple_parse<double>("1e400"s).is_valid() );
+    REQUIRE( simple_parse<double>("1e39"s).is_valid() );
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+#include "StreamReader.hpp"
+#ifdef CLINIARG_HAS_FD_READ
+#include <fcntl.h>
+#endif
+
+using namespace std::literals;
+
+TEST_CASE( "Streaming file reading" ) {
+    // tiny chunks: every line straddles chunk boundaries
+    for (size_t chunk_size : {1, 3, 7, 4096})
+    {
+        ini_stream_reader reader("test-file.ini"s, chunk_size);
+        std::vector<std::pair<std::string,std::string>> records;
+        while (const auto rec = reader.next())
+        {
+            REQUIRE( rec->is_valid() );
+            records.emplace_back(rec->get().key, rec->get().value);
+        }
+        REQUIRE( !reader.error() );
+        REQUIRE( records == std::vector<std::pair<std::string,std::string>>{{"truc","machin"},{"bidule","2"},{"blah","4,5,6"}} );
+    }
+#ifdef CLINIARG_HAS_FD_READ
+    const int fd = ::open("test-file.ini", O_RDONLY);
+    REQUIRE( fd >= 0 );
+    ini_stream_reader fd_reader(fd, 16);
+    REQUIRE( fd_reader.next()->get().key == "truc"sv );
+    ::close(fd);
+#endif
+    ini_stream_reader missing("no-such-file.ini"s);
+    REQUIRE( !missing.next() );
+    REQUIRE( missing.error() == FileAndArgsErrorsT::filenotopened );
+}
+
+TEST_CASE( "Streaming errors and offsets" ) {
+    std::istringstream in{"truc=machin\r\n\n# comment\nbidule\nblah=4,5,6"};
+    ini_stream_reader reader(in, 5);
+    const auto first = reader.next();
+    REQUIRE( first->get().offset == 0 );
+    const auto second = reader.next();
+    REQUIRE( !second->is_valid() );
+    REQUIRE( second->error() == std::make_pair(size_t{24}, ParsingErrorsT::keyvaluenotparsed) );
+    const auto third = reader.next();
+    REQUIRE( third->get().offset == 31 );
+    REQUIRE( third->get().value == "4,5,6"sv );
+    REQUIRE( vector_parse<size_t>(third->get().value).get() == std::vector<size_t>{4,5,6} );
+    REQUIRE( !reader.next() );
+}
+
+TEST_CASE( "Streaming memory stays bounded" ) {
+    std::string big;
+    for (size_t i = 0; i < 100000; ++i)
+        big += "key" + std::to_string(i) + "=" + std::to_string(i) + "\n";
+    std::istringstream in{big};
+    ini_stream_reader reader(in, 4096);
+    size_t count = 0;
+    while (const auto rec = reader.next())
+        count += rec->is_valid();
+    REQUIRE( count == 100000 );
+    REQUIRE( reader.lines().buffer_size() == 4096 );
+
+    std::istringstream long_line{"key=" + std::string(10000, '1')};
+    ini_stream_reader long_reader(long_line, 64);
+    REQUIRE( long_reader.next()->get().value.size() == 10000 );
+    REQUIRE( long_reader.lines().buffer_size() == 16384 );
+}
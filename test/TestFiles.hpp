@@ -0,0 +1,22 @@
+/**
+ * @file TestFiles.hpp
+ * @brief Helpers of the tests that write configuration files
+ *
+ */
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Replace the content of the file at path with txt, as is
+ *
+ * @param path
+ * @param txt
+ */
+inline void write_text(const std::filesystem::path& path, const std::string& txt)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << txt;
+}
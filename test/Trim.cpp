@@ -1,8 +1,38 @@
 #include <catch2/catch_test_macros.hpp>
 #include "TrimLower.hpp"
 
+using namespace std::literals;
+
 TEST_CASE( "Trim and lowercase") {
     REQUIRE( trim_spaces_underscores("Text\n __with\tsome \t  whitespaces and_ _underscores\n\n") == "Textwithsomewhitespacesandunderscores");
     REQUIRE( trim_spaces_underscores_andlower("Text\n __with\tsome \t  whitespaces and_ _underscores\n\n") == "textwithsomewhitespacesandunderscores");
+    REQUIRE( str_tolower("MiXeD_Case 42") == "mixed_case 42");
+    REQUIRE( trim_spaces_underscores_andlower("") == "");
+    REQUIRE( trim_spaces_underscores_andlower(" _\t\n") == "");
+}
+
+TEST_CASE( "Trim and lowercase of long strings") {
+    const std::string block = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyz\x80\xff";
+    const std::string text = block + " \t_" + block + block + "\n_" + block.substr(0, 5);
+    std::string expected = block + block + block + block.substr(0, 5);
+    std::string lowered;
+    for (char c : expected)
+        lowered += static_cast<char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+
+    REQUIRE( trim_spaces_underscores(text) == expected);
+    REQUIRE( trim_spaces_underscores_andlower(text) == lowered);
+    REQUIRE( trim_spaces_underscores_andlower(text, std::locale::classic()) == lowered);
 }
 
+TEST_CASE( "Trim and lowercase with a locale") {
+    const std::locale loc = std::locale::classic();
+    REQUIRE( trim_spaces_underscores(" A_b\tC ", loc) == "AbC");
+    REQUIRE( str_tolower("A_b\tC", loc) == "a_b\tc");
+    REQUIRE( trim_spaces_underscores_andlower(" A_b\tC ", loc) == "abc");
+}
+
+TEST_CASE( "Lazy normalization view") {
+    const auto key = " One_Vect \tFlot"sv;
+    REQUIRE( to<std::string>(normalized_view(key)) == "onevectflot");
+    REQUIRE( to<std::string>(normalized_view(" _ "sv)).empty());
+}
@@ -13,3 +13,13 @@ TEST_CASE( "Vector parsing") {
     REQUIRE( vector_parse<double>("1,-2,3.5"s).get() == std::vector<double>{1,-2,3.5} ); 
 }
 
+TEST_CASE( "Vector parsing edge cases") {
+    REQUIRE( vector_parse<int>(""s).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( vector_parse<int>(",,"s).error() == ParsingErrorsT::emptyvector );
+    REQUIRE( vector_parse<int>("1,,2,"s).get() == std::vector<int>{1,2} );
+    REQUIRE( vector_parse<int>("1,truc,2"s).error() == ParsingErrorsT::vectorvaluenotparsed );
+    REQUIRE( vector_parse<std::string>("truc,machin"s).get() == std::vector<std::string>{"truc","machin"} );
+
+    const std::string line{"blah=4,5,6"};
+    REQUIRE( vector_parse<float>(subrange(begin(line) + 5, end(line))).get() == std::vector<float>{4,5,6} );
+}